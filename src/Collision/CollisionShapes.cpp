@@ -0,0 +1,171 @@
+#include <Collision/CollisionShapes.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <Util/FastTrig.hpp>
+
+namespace {
+float dot(const sf::Vector2f& a, const sf::Vector2f& b) {
+    return a.x*b.x + a.y*b.y;
+}
+
+struct Axes {
+    sf::Vector2f x, y;
+
+    Axes(float rotation) {
+        float s, c;
+        FastTrig::sinCos(rotation, s, c);
+        x = {c, s};
+        y = {-s, c};
+    }
+};
+
+// Half the extent of the box when projected onto the axis
+float projectedRadius(const OrientedBox& box, const Axes& axes, const sf::Vector2f& axis) {
+    return box.halfSize.x * std::fabs(dot(axes.x, axis)) + box.halfSize.y * std::fabs(dot(axes.y, axis));
+}
+}
+
+sf::FloatRect OrientedBox::getBounds() const {
+    const Axes axes(rotation);
+    const sf::Vector2f extent(
+        halfSize.x * std::fabs(axes.x.x) + halfSize.y * std::fabs(axes.y.x),
+        halfSize.x * std::fabs(axes.x.y) + halfSize.y * std::fabs(axes.y.y)
+    );
+    return sf::FloatRect(center - extent, extent * 2.0f);
+}
+
+bool Collision::intersects(const Circle& a, const Circle& b) {
+    const sf::Vector2f d = a.center - b.center;
+    const float r = a.radius + b.radius;
+    return dot(d, d) <= r*r;
+}
+
+bool Collision::intersects(const Circle& circle, const OrientedBox& box) {
+    // Find the closest point of the box in its own frame
+    const Axes axes(box.rotation);
+    const sf::Vector2f d = circle.center - box.center;
+    const float lx = std::clamp(dot(d, axes.x), -box.halfSize.x, box.halfSize.x);
+    const float ly = std::clamp(dot(d, axes.y), -box.halfSize.y, box.halfSize.y);
+    const sf::Vector2f offset = d - axes.x * lx - axes.y * ly;
+    return dot(offset, offset) <= circle.radius * circle.radius;
+}
+
+bool Collision::intersects(const OrientedBox& a, const OrientedBox& b) {
+    // Separating axis test on the face normals of both boxes
+    const Axes aAxes(a.rotation);
+    const Axes bAxes(b.rotation);
+    const sf::Vector2f d = b.center - a.center;
+    const sf::Vector2f axes[4] = {aAxes.x, aAxes.y, bAxes.x, bAxes.y};
+    for (const sf::Vector2f& axis : axes) {
+        const float distance = std::fabs(dot(d, axis));
+        if (distance > projectedRadius(a, aAxes, axis) + projectedRadius(b, bAxes, axis))
+            return false;
+    }
+    return true;
+}
+
+bool Collision::sweep(const Circle& a, const sf::Vector2f& aMotion,
+                      const Circle& b, const sf::Vector2f& bMotion, float& toi) {
+    // Solve |p + v*t| = r for the first t in [0, 1], in the frame of b
+    const sf::Vector2f p = a.center - b.center;
+    const sf::Vector2f v = aMotion - bMotion;
+    const float r = a.radius + b.radius;
+    const float c = dot(p, p) - r*r;
+    if (c <= 0) {
+        toi = 0;
+        return true;
+    }
+
+    const float vv = dot(v, v);
+    const float pv = dot(p, v);
+    if (vv <= 0 || pv >= 0)
+        return false;
+
+    const float discriminant = pv*pv - vv*c;
+    if (discriminant < 0)
+        return false;
+
+    toi = (-pv - std::sqrt(discriminant)) / vv;
+    return toi <= 1;
+}
+
+bool Collision::sweep(const Circle& a, const sf::Vector2f& aMotion,
+                      const OrientedBox& b, const sf::Vector2f& bMotion, float& toi) {
+    if (intersects(a, b)) {
+        toi = 0;
+        return true;
+    }
+
+    // Move the circle center as a ray in the frame of the box, against the box grown by the radius
+    const Axes axes(b.rotation);
+    const sf::Vector2f d = a.center - b.center;
+    const sf::Vector2f v = aMotion - bMotion;
+    const float p[2] = {dot(d, axes.x), dot(d, axes.y)};
+    const float dir[2] = {dot(v, axes.x), dot(v, axes.y)};
+    const float half[2] = {b.halfSize.x, b.halfSize.y};
+
+    float enter = 0, exit = 1;
+    for (unsigned int i = 0; i < 2; ++i) {
+        const float extent = half[i] + a.radius;
+        if (dir[i] == 0) {
+            if (std::fabs(p[i]) > extent)
+                return false;
+            continue;
+        }
+        float t0 = (-extent - p[i]) / dir[i];
+        float t1 = (extent - p[i]) / dir[i];
+        if (t0 > t1)
+            std::swap(t0, t1);
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        if (enter > exit)
+            return false;
+    }
+
+    // Entering through a face is exact. In a corner region only the rounded corner can be hit
+    const float qx = p[0] + dir[0] * enter;
+    const float qy = p[1] + dir[1] * enter;
+    if (std::fabs(qx) <= half[0] || std::fabs(qy) <= half[1]) {
+        toi = enter;
+        return true;
+    }
+
+    Circle corner;
+    corner.center = b.center + axes.x * std::copysign(half[0], qx) + axes.y * std::copysign(half[1], qy);
+    return sweep(a, aMotion, corner, bMotion, toi);
+}
+
+bool Collision::sweep(const OrientedBox& a, const sf::Vector2f& aMotion,
+                      const OrientedBox& b, const sf::Vector2f& bMotion, float& toi) {
+    // Separating axis test over the step: each axis gives the interval in which the projections
+    // overlap, and the boxes touch where all of the intervals do
+    const Axes aAxes(a.rotation);
+    const Axes bAxes(b.rotation);
+    const sf::Vector2f d = a.center - b.center;
+    const sf::Vector2f v = aMotion - bMotion;
+    const sf::Vector2f axes[4] = {aAxes.x, aAxes.y, bAxes.x, bAxes.y};
+
+    float enter = 0, exit = 1;
+    for (const sf::Vector2f& axis : axes) {
+        const float distance = dot(d, axis);
+        const float speed = dot(v, axis);
+        const float extent = projectedRadius(a, aAxes, axis) + projectedRadius(b, bAxes, axis);
+        if (speed == 0) {
+            if (std::fabs(distance) > extent)
+                return false;
+            continue;
+        }
+        float t0 = (-extent - distance) / speed;
+        float t1 = (extent - distance) / speed;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        if (enter > exit)
+            return false;
+    }
+
+    toi = enter;
+    return true;
+}
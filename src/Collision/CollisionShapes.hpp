@@ -0,0 +1,66 @@
+#ifndef COLLISIONSHAPES_HPP
+#define COLLISIONSHAPES_HPP
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * Circle collision shape
+ */
+struct Circle {
+    sf::Vector2f center;
+    float radius = 0;
+};
+
+/**
+ * Box collision shape that may be rotated about its center. Rotation is in degrees, clockwise
+ */
+struct OrientedBox {
+    sf::Vector2f center;
+    sf::Vector2f halfSize;
+    float rotation = 0;
+
+    /**
+     * Returns the axis aligned box that contains this box
+     */
+    sf::FloatRect getBounds() const;
+};
+
+/**
+ * Narrowphase intersection and swept tests between collision shapes
+ */
+struct Collision {
+    static bool intersects(const Circle& a, const Circle& b);
+    static bool intersects(const Circle& circle, const OrientedBox& box);
+    static bool intersects(const OrientedBox& a, const OrientedBox& b);
+
+    /**
+     * Tests two circles moving linearly over a step for contact
+     *
+     * \param a The first circle at the start of the step
+     * \param aMotion How far the first circle moves over the step
+     * \param b The second circle at the start of the step
+     * \param bMotion How far the second circle moves over the step
+     * \param toi Set to the fraction of the step, in [0, 1], at which they first touch
+     * \return True if the circles touch during the step
+     */
+    static bool sweep(const Circle& a, const sf::Vector2f& aMotion,
+                      const Circle& b, const sf::Vector2f& bMotion, float& toi);
+
+    /**
+     * Tests a moving circle against a moving box. The box keeps its rotation over the step
+     *
+     * \see sweep(const Circle&, const sf::Vector2f&, const Circle&, const sf::Vector2f&, float&)
+     */
+    static bool sweep(const Circle& a, const sf::Vector2f& aMotion,
+                      const OrientedBox& b, const sf::Vector2f& bMotion, float& toi);
+
+    /**
+     * Tests two moving boxes. The boxes keep their rotation over the step
+     *
+     * \see sweep(const Circle&, const sf::Vector2f&, const Circle&, const sf::Vector2f&, float&)
+     */
+    static bool sweep(const OrientedBox& a, const sf::Vector2f& aMotion,
+                      const OrientedBox& b, const sf::Vector2f& bMotion, float& toi);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include <Collision/SweepAndPrune.hpp>
+
+#include <algorithm>
+
+void SweepAndPrune::update(const std::vector<sf::FloatRect>& boxes) {
+    // The previous order is only reusable if it refers to the same number of boxes
+    if (order.size() != boxes.size()) {
+        order.resize(boxes.size());
+        for (unsigned int i = 0; i < order.size(); ++i)
+            order[i] = i;
+    }
+
+    for (unsigned int i = 1; i < order.size(); ++i) {
+        const unsigned int index = order[i];
+        const float left = boxes[index].left;
+        unsigned int j = i;
+        for (; j > 0 && boxes[order[j-1]].left > left; --j)
+            order[j] = order[j-1];
+        order[j] = index;
+    }
+
+    pairs.clear();
+    for (unsigned int i = 0; i < order.size(); ++i) {
+        const sf::FloatRect& a = boxes[order[i]];
+        const float right = a.left + a.width;
+        for (unsigned int j = i + 1; j < order.size() && boxes[order[j]].left <= right; ++j) {
+            const sf::FloatRect& b = boxes[order[j]];
+            if (a.top <= b.top + b.height && b.top <= a.top + a.height)
+                pairs.emplace_back(std::min(order[i], order[j]), std::max(order[i], order[j]));
+        }
+    }
+}
+
+const std::vector<SweepAndPrune::Pair>& SweepAndPrune::getPairs() const {
+    return pairs;
+}
@@ -0,0 +1,32 @@
+#ifndef SWEEPANDPRUNE_HPP
+#define SWEEPANDPRUNE_HPP
+
+#include <utility>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/**
+ * Sweep and prune broadphase. Boxes are sorted along the x axis and only neighbours whose x ranges
+ * overlap are tested on y. The sort order is kept between updates and refined with an insertion
+ * sort, so when objects move a little each step sorting is close to linear
+ */
+class SweepAndPrune {
+public:
+    typedef std::pair<unsigned int, unsigned int> Pair;
+
+    /**
+     * Finds all pairs of overlapping boxes. Pairs refer to indices into boxes, lowest first
+     */
+    void update(const std::vector<sf::FloatRect>& boxes);
+
+    /**
+     * Returns the overlapping pairs found by the last update
+     */
+    const std::vector<Pair>& getPairs() const;
+
+private:
+    std::vector<unsigned int> order;
+    std::vector<Pair> pairs;
+};
+
+#endif
\ No newline at end of file
@@ -18,17 +18,21 @@ Entity::Ptr ControllableEntity::create(
     float mass, bool canMove, bool hasGravity, float gRange,
     EntityController::Ptr controller)
 {
-    return Entity::Ptr(new ControllableEntity(
+    return makePtr(new ControllableEntity(
         name, animFile, position, velocity, mass, canMove, hasGravity, gRange, controller
     ));
 }
 
 Entity::Ptr ControllableEntity::createPlayer(const sf::Vector2f& position, const sf::Vector2f& velocity) {
-    return Entity::Ptr(new ControllableEntity(
+    return makePtr(new ControllableEntity(
         "Player", "Ships/ship.anim", position, velocity, 10, true, false, -1, PlayerController::create()
     ));
 }
 
+void ControllableEntity::setController(EntityController::Ptr c) {
+    controller = c;
+}
+
 void ControllableEntity::customUpdateLogic(float dt) {
     controller->update(this, dt);
 }
\ No newline at end of file
@@ -29,6 +29,11 @@ public:
 
     virtual ~ControllableEntity() = default;
 
+    /**
+     * Replaces the controller, for example to play back recorded input
+     */
+    void setController(EntityController::Ptr controller);
+
 private:
     EntityController::Ptr controller;
 
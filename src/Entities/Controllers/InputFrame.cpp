@@ -0,0 +1,16 @@
+#include <Entities/Controllers/InputFrame.hpp>
+
+#include <SFML/Window.hpp>
+
+InputFrame InputFrame::fromKeyboard() {
+    InputFrame frame;
+    frame.setPressed(Forward, sf::Keyboard::isKeyPressed(sf::Keyboard::W));
+    frame.setPressed(Right, sf::Keyboard::isKeyPressed(sf::Keyboard::D));
+    frame.setPressed(Back, sf::Keyboard::isKeyPressed(sf::Keyboard::S));
+    frame.setPressed(Left, sf::Keyboard::isKeyPressed(sf::Keyboard::A));
+    frame.setPressed(RotateClockwise, sf::Keyboard::isKeyPressed(sf::Keyboard::E));
+    frame.setPressed(RotateCounterClockwise, sf::Keyboard::isKeyPressed(sf::Keyboard::Q));
+    frame.setPressed(EnterOrbit, sf::Keyboard::isKeyPressed(sf::Keyboard::C));
+    frame.setPressed(LeaveOrbit, sf::Keyboard::isKeyPressed(sf::Keyboard::V));
+    return frame;
+}
\ No newline at end of file
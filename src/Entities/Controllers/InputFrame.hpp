@@ -0,0 +1,45 @@
+#ifndef INPUTFRAME_HPP
+#define INPUTFRAME_HPP
+
+#include <cstdint>
+
+/**
+ * The player input for a single tick. Controllers act on frames instead of polling the keyboard
+ * so that input can be recorded and played back
+ */
+struct InputFrame {
+    /**
+     * Buttons that can be held. Values are bits in buttons
+     */
+    enum Button : std::uint8_t {
+        Forward = 1 << 0,
+        Right = 1 << 1,
+        Back = 1 << 2,
+        Left = 1 << 3,
+        RotateClockwise = 1 << 4,
+        RotateCounterClockwise = 1 << 5,
+        EnterOrbit = 1 << 6,
+        LeaveOrbit = 1 << 7
+    };
+
+    std::uint8_t buttons = 0;
+
+    /**
+     * Returns whether the button is held
+     */
+    bool isPressed(Button button) const { return (buttons & button) != 0; }
+
+    /**
+     * Sets whether the button is held
+     */
+    void setPressed(Button button, bool pressed) {
+        buttons = pressed ? (buttons | button) : (buttons & ~button);
+    }
+
+    /**
+     * Reads the current state of the keyboard
+     */
+    static InputFrame fromKeyboard();
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <Entities/Controllers/InputRecording.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <Util/ByteStream.hpp>
+
+namespace {
+constexpr char Magic[4] = {'S', 'R', 'I', 'R'};
+constexpr std::uint32_t Version = 2; // 2 added the final checksum
+constexpr std::size_t MaxLength = 1 << 30; // guards allocations against corrupt files
+}
+
+InputRecording::InputRecording(const std::string& environmentFile, std::uint64_t seed, float tickLength)
+: environmentFile(environmentFile)
+, seed(seed)
+, tickLength(tickLength)
+, hasChecksum(false)
+, finalChecksum(0) {}
+
+InputRecording::Ptr InputRecording::create(const std::string& environmentFile, std::uint64_t seed, float tickLength) {
+    return Ptr(new InputRecording(environmentFile, seed, tickLength));
+}
+
+void InputRecording::append(const InputFrame& frame) {
+    frames.push_back(frame);
+}
+
+unsigned int InputRecording::size() const {
+    return frames.size();
+}
+
+const InputFrame& InputRecording::getFrame(unsigned int tick) const {
+    return frames[tick];
+}
+
+void InputRecording::setFinalChecksum(std::uint32_t checksum) {
+    hasChecksum = true;
+    finalChecksum = checksum;
+}
+
+bool InputRecording::hasFinalChecksum() const {
+    return hasChecksum;
+}
+
+const std::string& InputRecording::getEnvironmentFile() const {
+    return environmentFile;
+}
+
+std::uint64_t InputRecording::getSeed() const {
+    return seed;
+}
+
+float InputRecording::getTickLength() const {
+    return tickLength;
+}
+
+std::uint32_t InputRecording::getFinalChecksum() const {
+    return finalChecksum;
+}
+
+bool InputRecording::save(const std::string& file) const {
+    std::vector<std::uint8_t> data;
+    ByteWriter writer(data);
+    writer.bytes(Magic, 4);
+    writer.u32(Version);
+    std::uint32_t tickBits;
+    std::memcpy(&tickBits, &tickLength, 4);
+    writer.u32(tickBits);
+    writer.u32(seed & 0xFFFFFFFF);
+    writer.u32(seed >> 32);
+    writer.u32(environmentFile.size());
+    writer.bytes(environmentFile.data(), environmentFile.size());
+    writer.u32(frames.size());
+
+    // Runs of (length, buttons)
+    for (unsigned int i = 0; i < frames.size();) {
+        unsigned int run = 1;
+        while (i + run < frames.size() && frames[i + run].buttons == frames[i].buttons)
+            ++run;
+        writer.varint(run);
+        writer.u8(frames[i].buttons);
+        i += run;
+    }
+    writer.u8(hasChecksum ? 1 : 0);
+    writer.u32(finalChecksum);
+
+    std::ofstream output(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!output.good()) {
+        std::cerr << "Failed to write input recording: " << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+InputRecording::Ptr InputRecording::load(const std::string& file) {
+    std::ifstream input(file.c_str(), std::ios::in | std::ios::binary);
+    if (!input.good()) {
+        std::cerr << "Failed to open input recording: " << file << std::endl;
+        return nullptr;
+    }
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (data.size() < 4 || std::memcmp(data.data(), Magic, 4) != 0) {
+        std::cerr << "Not an input recording: " << file << std::endl;
+        return nullptr;
+    }
+
+    ByteReader reader(data.data() + 4, data.size() - 4);
+    const std::uint32_t version = reader.u32();
+    if (version < 1 || version > Version) {
+        std::cerr << "Unsupported input recording version " << version << ": " << file << std::endl;
+        return nullptr;
+    }
+    const std::uint32_t tickBits = reader.u32();
+    float tickLength;
+    std::memcpy(&tickLength, &tickBits, 4);
+    std::uint64_t seed = reader.u32();
+    seed |= static_cast<std::uint64_t>(reader.u32()) << 32;
+
+    const std::uint32_t nameLength = reader.u32();
+    const std::uint8_t* name = reader.bytes(nameLength);
+    if (reader.hasFailed()) {
+        std::cerr << "Input recording is corrupt: " << file << std::endl;
+        return nullptr;
+    }
+    const std::string environmentFile(name, name + nameLength);
+
+    Ptr recording(new InputRecording(environmentFile, seed, tickLength));
+    const std::uint32_t frameCount = reader.u32();
+    if (frameCount > MaxLength) {
+        std::cerr << "Input recording is corrupt: " << file << std::endl;
+        return nullptr;
+    }
+    recording->frames.reserve(frameCount);
+    while (!reader.hasFailed() && recording->frames.size() < frameCount) {
+        const std::uint32_t run = reader.varint();
+        InputFrame frame;
+        frame.buttons = reader.u8();
+        if (run == 0 || run > frameCount - recording->frames.size())
+            reader.fail();
+        else
+            recording->frames.insert(recording->frames.end(), run, frame);
+    }
+    if (version >= 2) {
+        recording->hasChecksum = reader.u8() != 0;
+        recording->finalChecksum = reader.u32();
+    }
+    if (reader.hasFailed()) {
+        std::cerr << "Input recording is corrupt: " << file << std::endl;
+        return nullptr;
+    }
+    return recording;
+}
\ No newline at end of file
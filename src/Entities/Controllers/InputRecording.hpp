@@ -0,0 +1,82 @@
+#ifndef INPUTRECORDING_HPP
+#define INPUTRECORDING_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <Entities/Controllers/InputFrame.hpp>
+
+/**
+ * Player input for every tick of a run, along with what is needed to reproduce the run: the
+ * environment, the random seed and the fixed tick length. Replaying the frames with the same
+ * seed and tick length gives the same simulation
+ *
+ * Input rarely changes between ticks, so frames are stored run length encoded. The checksum of the
+ * final simulation state is stored as well so that playback can tell when it has diverged
+ */
+class InputRecording {
+public:
+    typedef std::shared_ptr<InputRecording> Ptr;
+
+    /**
+     * Creates an empty recording
+     *
+     * \param environmentFile The environment the run is in, relative to the environment path
+     * \param seed The random seed the run was started with
+     * \param tickLength The fixed time step of the run, in seconds
+     */
+    static Ptr create(const std::string& environmentFile, std::uint64_t seed, float tickLength);
+
+    /**
+     * Loads a recording written by save(). Returns null on error
+     */
+    static Ptr load(const std::string& file);
+
+    /**
+     * Writes the recording to the file
+     */
+    bool save(const std::string& file) const;
+
+    /**
+     * Adds the input for the next tick
+     */
+    void append(const InputFrame& frame);
+
+    /**
+     * Returns the number of recorded ticks
+     */
+    unsigned int size() const;
+
+    /**
+     * Returns the input for the given tick
+     */
+    const InputFrame& getFrame(unsigned int tick) const;
+
+    /**
+     * Sets the checksum of the simulation state after the last tick, from Snapshot::checksum()
+     */
+    void setFinalChecksum(std::uint32_t checksum);
+
+    /**
+     * Returns true if the final checksum is known. Recordings from older versions do not have it
+     */
+    bool hasFinalChecksum() const;
+
+    const std::string& getEnvironmentFile() const;
+    std::uint64_t getSeed() const;
+    float getTickLength() const;
+    std::uint32_t getFinalChecksum() const;
+
+private:
+    std::string environmentFile;
+    std::uint64_t seed;
+    float tickLength;
+    bool hasChecksum;
+    std::uint32_t finalChecksum;
+    std::vector<InputFrame> frames;
+
+    InputRecording(const std::string& environmentFile, std::uint64_t seed, float tickLength);
+};
+
+#endif
\ No newline at end of file
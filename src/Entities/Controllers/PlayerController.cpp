@@ -1,39 +1,49 @@
 #include <Entities/Controllers/PlayerController.hpp>
 
 #include <cmath>
-#include <SFML/System.hpp>
 #include <Entities/Entity.hpp>
 #include <Util/AngularVector.hpp>
 #include <Entities/MotionTypes/OrbitalMotion.hpp>
 #include <Entities/MotionTypes/PhysicsMotion.hpp>
 
-EntityController::Ptr PlayerController::create() {
-    return EntityController::Ptr(new PlayerController());
+EntityController::Ptr PlayerController::create(InputRecording::Ptr recording) {
+    return EntityController::Ptr(new PlayerController(recording));
 }
 
-PlayerController::PlayerController() {
+PlayerController::PlayerController(InputRecording::Ptr recording)
+: recording(recording) {
     //TODO - load/init controls
 }
 
-void PlayerController::update(Entity* entity, float dt) {
-    AngularVectorF a(1000, entity->getRotation());
+void PlayerController::update(Entity* entity, float) {
+    const InputFrame input = InputFrame::fromKeyboard();
+    if (recording)
+        recording->append(input);
+    applyInput(entity, input);
+}
+
+void PlayerController::applyInput(Entity* entity, const InputFrame& input) {
+    // Thrust in the other directions is a quarter turn of the forward vector
+    const CachedAngularVectorF a(1000, entity->getRotation());
+    const sf::Vector2f& forward = a.cartesian();
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W))
-        entity->applyAcceleration(a.toCartesian());
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::D))
-        entity->applyAcceleration(a.rotate(90).toCartesian());
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
-        entity->applyAcceleration(a.rotate(180).toCartesian());
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::A))
-        entity->applyAcceleration(a.rotate(270).toCartesian());
+    if (input.isPressed(InputFrame::Forward))
+        entity->applyAcceleration(forward);
+    else if (input.isPressed(InputFrame::Right))
+        entity->applyAcceleration({-forward.y, forward.x});
+    else if (input.isPressed(InputFrame::Back))
+        entity->applyAcceleration(-forward);
+    else if (input.isPressed(InputFrame::Left))
+        entity->applyAcceleration({forward.y, -forward.x});
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::E))
+    if (input.isPressed(InputFrame::RotateClockwise))
         entity->applyRotation(120);
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Q))
+    else if (input.isPressed(InputFrame::RotateCounterClockwise))
         entity->applyRotation(-120);
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::C) && entity->currentParentBody())
-        entity->changeMotionType(OrbitalMotion::create(entity->currentParentBody(), entity));
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::V))
+    const Entity* parentBody = entity->currentParentBody().get();
+    if (input.isPressed(InputFrame::EnterOrbit) && parentBody)
+        entity->changeMotionType(OrbitalMotion::create(*parentBody, entity));
+    else if (input.isPressed(InputFrame::LeaveOrbit))
         entity->changeMotionType(PhysicsMotion::create(entity->getPosition(), entity->getVelocity()));
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define PLAYERCONTROLLER_HPP
 
 #include <Entities/EntityController.hpp>
+#include <Entities/Controllers/InputRecording.hpp>
 
 /**
  * EntityController that takes player input and handles fuel usage
@@ -10,14 +11,26 @@ class PlayerController : public EntityController {
 public:
     virtual ~PlayerController() = default;
 
-    static EntityController::Ptr create();
+    /**
+     * Creates a controller that reads the keyboard
+     *
+     * \param recording If given, the input of every tick is appended to it
+     */
+    static EntityController::Ptr create(InputRecording::Ptr recording = nullptr);
 
     virtual void update(Entity* entity, float dt) override;
 
+    /**
+     * Applies one tick of input to the entity. Shared by everything that drives the player so
+     * that live and replayed input behave the same
+     */
+    static void applyInput(Entity* entity, const InputFrame& input);
+
 private:
     //TODO - fuel, controls, etc
+    InputRecording::Ptr recording;
 
-    PlayerController();
+    PlayerController(InputRecording::Ptr recording);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include <Entities/Controllers/ReplayController.hpp>
+
+#include <Entities/Controllers/PlayerController.hpp>
+
+EntityController::Ptr ReplayController::create(InputRecording::Ptr recording) {
+    return EntityController::Ptr(new ReplayController(recording));
+}
+
+ReplayController::ReplayController(InputRecording::Ptr recording)
+: recording(recording)
+, tick(0) {}
+
+void ReplayController::update(Entity* entity, float) {
+    if (finished())
+        return;
+    PlayerController::applyInput(entity, recording->getFrame(tick));
+    ++tick;
+}
+
+bool ReplayController::finished() const {
+    return tick >= recording->size();
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef REPLAYCONTROLLER_HPP
+#define REPLAYCONTROLLER_HPP
+
+#include <Entities/EntityController.hpp>
+#include <Entities/Controllers/InputRecording.hpp>
+
+/**
+ * EntityController that plays back recorded player input, one frame per tick. No input is applied
+ * once the recording runs out
+ */
+class ReplayController : public EntityController {
+public:
+    virtual ~ReplayController() = default;
+
+    static EntityController::Ptr create(InputRecording::Ptr recording);
+
+    virtual void update(Entity* entity, float dt) override;
+
+    /**
+     * Returns true once every recorded frame has been applied
+     */
+    bool finished() const;
+
+private:
+    InputRecording::Ptr recording;
+    unsigned int tick;
+
+    ReplayController(InputRecording::Ptr recording);
+};
+
+#endif
\ No newline at end of file
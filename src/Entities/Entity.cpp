@@ -10,6 +10,31 @@
 
 namespace {
 const float minAccel = 20; // minimum for gravity to apply
+
+/**
+ * Handle table. Slots are reused and their generation is bumped when an Entity is destroyed so
+ * that stale handles resolve to null
+ */
+struct HandleSlot {
+    Entity* entity;
+    std::uint32_t generation;
+};
+struct HandleTable {
+    std::vector<HandleSlot> slots{{nullptr, 0}}; // slot 0 is the null handle
+    std::vector<std::uint32_t> freeSlots;
+};
+
+HandleTable& handleTable() {
+    // Created on first use and never destroyed so that Entities released during static
+    // destruction can still free their slot
+    static HandleTable* table = new HandleTable();
+    return *table;
+}
+}
+
+Entity* Entity::Handle::get() const {
+    const HandleSlot& slot = handleTable().slots[index];
+    return slot.generation == generation ? slot.entity : nullptr;
 }
 
 Entity::Entity(
@@ -22,60 +47,84 @@ Entity::Entity(
 , rotation(0)
 , rotationRate(0)
 , motion(PhysicsMotion::create(position, velocity))
+, previousPosition(position)
 , mass(mass)
-, gravitationalRange(gRange <= 0 ? std::sqrt(Properties::GravitationalConstant * mass)/minAccel : gRange)
+, gravitationalRange(gRange <= 0 ? defaultGravitationalRange(mass) : gRange)
 , gRangeSqrd(gravitationalRange * gravitationalRange)
 , minGravDist((animation.getSize().x + animation.getSize().y)/2)
 , canMove(canMove), hasGravity(hasGravity)
+, handle(acquireHandle(this))
+, strongestGravity(0)
 {
     motion->setMotionEnabled(canMove);
 }
 
+Entity::~Entity() {
+    HandleTable& table = handleTable();
+    HandleSlot& slot = table.slots[handle.index];
+    slot.entity = nullptr;
+    slot.generation += 1;
+    table.freeSlots.push_back(handle.index);
+}
+
+Entity::Handle Entity::acquireHandle(Entity* entity) {
+    HandleTable& table = handleTable();
+    if (table.freeSlots.empty()) {
+        table.slots.push_back({entity, 1});
+        return Handle(table.slots.size() - 1, 1);
+    }
+    const std::uint32_t index = table.freeSlots.back();
+    table.freeSlots.pop_back();
+    table.slots[index].entity = entity;
+    return Handle(index, table.slots[index].generation);
+}
+
+Entity::Ptr Entity::makePtr(Entity* entity) {
+    return Entity::Ptr(entity, std::default_delete<Entity>(), PoolAllocator<Entity>());
+}
+
+Entity::Handle Entity::getHandle() const {
+    return handle;
+}
+
 Entity::Ptr Entity::create(
     const std::string& name, const std::string& animFile,
     const sf::Vector2f& position, const sf::Vector2f& velocity,
     float mass, bool canMove, bool hasGravity, float gRange
 ) {
-    return Entity::Ptr(new Entity(
+    return makePtr(new Entity(
         name, animFile, position, velocity, mass, canMove, hasGravity, gRange
     ));
 }
 
+Entity::Ptr Entity::create(const EntitySpec& spec) {
+    return Entity::create(
+        spec.name, spec.gfx, {spec.x, spec.y}, {spec.vx, spec.vy},
+        spec.mass, spec.canMove, spec.hasGravity, spec.gravityRange
+    );
+}
+
 Entity::Ptr Entity::create(const JsonGroup& data) {
-    if (!Schemas::entitySchema().validate(data, true))
+    EntitySpec spec;
+    if (!Schemas::entityBinding().load(data, spec, true))
         return nullptr;
+    return Entity::create(spec);
+}
 
-    float gRange = 0;
-    if (data.hasField("gravityRange"))
-        gRange = *data.getField("gravityRange")->getAsNumeric();
-    return Entity::create(
-        *data.getField("name")->getAsString(),
-        *data.getField("gfx")->getAsString(),
-        {
-            *data.getField("x")->getAsNumeric(),
-            *data.getField("y")->getAsNumeric()
-        },
-        {
-            *data.getField("vx")->getAsNumeric(),
-            *data.getField("vy")->getAsNumeric()
-        },
-        *data.getField("mass")->getAsNumeric(),
-        *data.getField("canMove")->getAsBool(),
-        *data.getField("hasGravity")->getAsBool(),
-        gRange
-    );
+float Entity::defaultGravitationalRange(float mass) {
+    return std::sqrt(Properties::GravitationalConstant * mass) / minAccel;
 }
 
 void Entity::update(float dt) {
     customUpdateLogic(dt);
-    animation.update();
 
+    previousPosition = motion->getPosition();
     motion->update(this, dt);
 
     rotation += rotationRate * dt;
     rotationRate = 0;
-    strongestGravity.magnitude = 0;
-    parentBody = nullptr;
+    strongestGravity = 0;
+    parentBody = Handle();
 }
 
 const std::string& Entity::getName() const {
@@ -83,10 +132,27 @@ const std::string& Entity::getName() const {
 }
 
 sf::FloatRect Entity::getBoundingBox() const {
-    return sf::FloatRect(
-        motion->getPosition() - animation.getSize() / 2.0f,
-        animation.getSize()
-    );
+    return getCollisionBox().getBounds();
+}
+
+bool Entity::isRound() const {
+    return hasGravity;
+}
+
+Circle Entity::getCollisionCircle() const {
+    const sf::Vector2f size = animation.getSize();
+    Circle circle;
+    circle.center = motion->getPosition();
+    circle.radius = hasGravity ? (size.x + size.y) / 4 : std::min(size.x, size.y) / 2;
+    return circle;
+}
+
+OrientedBox Entity::getCollisionBox() const {
+    OrientedBox box;
+    box.center = motion->getPosition();
+    box.halfSize = animation.getSize() / 2.0f;
+    box.rotation = rotation;
+    return box;
 }
 
 float Entity::distanceToSquared(const sf::Vector2f& pos) const {
@@ -99,6 +165,22 @@ float Entity::getRotation() const {
     return rotation;
 }
 
+void Entity::setRotation(float r) {
+    rotation = r;
+}
+
+unsigned int Entity::getAnimationFrame() const {
+    return animation.getCurrentFrame();
+}
+
+void Entity::setAnimationFrame(unsigned int frame) {
+    animation.setFrame(frame);
+}
+
+void Entity::updateAnimation(float dt) {
+    animation.update(dt);
+}
+
 void Entity::applyRotation(float rate) {
     rotationRate += rate;
 }
@@ -111,6 +193,23 @@ const sf::Vector2f& Entity::getVelocity() const {
     return motion->getVelocity();
 }
 
+const sf::Vector2f& Entity::getPreviousPosition() const {
+    return previousPosition;
+}
+
+bool Entity::isMovable() const {
+    return canMove;
+}
+
+void Entity::resolveImpact(float toi, const sf::Vector2f& normal, float dt) {
+    const sf::Vector2f contact = previousPosition + (motion->getPosition() - previousPosition) * toi;
+    sf::Vector2f velocity = motion->getVelocity();
+    const float into = velocity.x*normal.x + velocity.y*normal.y;
+    if (into < 0)
+        velocity -= normal * into;
+    motion->correct(contact + velocity * dt * (1 - toi), velocity);
+}
+
 float Entity::getMass() const {
     return mass;
 }
@@ -127,38 +226,46 @@ sf::Vector2f Entity::getGravitationalAcceleration(const sf::Vector2f& pos) const
 
     const float dx = motion->getPosition().x - pos.x;
     const float dy = motion->getPosition().y - pos.y;
-    const float angle = std::atan2(dy, dx);
-    const float distSqrd = std::max(dx*dx + dy*dy, minGravDist*minGravDist);
+    const float realDistSqrd = dx*dx + dy*dy;
+    if (realDistSqrd <= 0)
+        return sf::Vector2f(0, 0);
+    const float distSqrd = std::max(realDistSqrd, minGravDist*minGravDist);
     const float accel = Properties::GravitationalConstant * mass / distSqrd;
 
-    return sf::Vector2f(
-        accel * std::cos(angle),
-        accel * std::sin(angle)
-    );
+    // Scaling the offset by the inverse distance gives the direction without any trig
+    return accel / std::sqrt(realDistSqrd) * sf::Vector2f(dx, dy);
 }
 
-sf::Vector2f Entity::getGravitationalAcceleration(Entity::Ptr entity) const {
-    return getGravitationalAcceleration(entity->getPosition());
+sf::Vector2f Entity::getGravitationalAcceleration(const Entity& entity) const {
+    return getGravitationalAcceleration(entity.getPosition());
 }
 
-void Entity::applyGravityToEntity(Entity::Ptr entity) {
-    if (hasGravity && this != entity.get()) {
-        if (distanceToSquared(entity->getPosition()) <= gRangeSqrd) {
+void Entity::applyGravityToEntity(Entity& entity) {
+    if (hasGravity && this != &entity) {
+        if (distanceToSquared(entity.getPosition()) <= gRangeSqrd) {
             const sf::Vector2f gravity = getGravitationalAcceleration(entity);
-            entity->applyAcceleration(gravity);
-            const AngularVectorF rGrav(gravity);
-            if (entity->strongestGravity.magnitude < rGrav.magnitude) {
-                entity->strongestGravity = rGrav;
-                entity->parentBody = shared_from_this();
+            entity.applyAcceleration(gravity);
+            const float strength = gravity.x*gravity.x + gravity.y*gravity.y;
+            if (entity.strongestGravity < strength) {
+                entity.strongestGravity = strength;
+                entity.parentBody = handle;
             }
         }
     }
 }
 
-Entity::Ptr Entity::currentParentBody() const {
+Entity::Handle Entity::currentParentBody() const {
     return parentBody;
 }
 
+const EntityMotion& Entity::getMotion() const {
+    return *motion;
+}
+
+EntityMotion& Entity::getMotion() {
+    return *motion;
+}
+
 void Entity::changeMotionType(EntityMotion::Ptr newMotion) {
     motion = newMotion;
     motion->setMotionEnabled(canMove);
@@ -172,7 +279,7 @@ void Entity::applyAcceleration(const sf::Vector2f& a) {
     motion->applyAcceleration(a);
 }
 
-void Entity::render(sf::RenderTarget& target) {
+void Entity::render(CountingRenderTarget& target) {
     if (hasGravity) {
         const float gRange = getGravitationalRange();
         const float darkestBlue = 255 - std::min(mass / 10000.0f * 40.0f, 255.0f);
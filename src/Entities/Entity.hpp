@@ -1,25 +1,62 @@
 #ifndef ENTITY_HPP
 #define ENTITY_HPP
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <list>
 
 #include <SFML/Graphics.hpp>
 
+#include <Collision/CollisionShapes.hpp>
 #include <Entities/EntityMotion.hpp>
+#include <Entities/EntitySpec.hpp>
 #include <Media/Animation.hpp>
 #include <Util/ResourceTypes.hpp>
 #include <Util/AngularVector.hpp>
 #include <Util/JsonFile.hpp>
+#include <Util/SlabAllocator.hpp>
 
 /**
- * Base class for any object that can exist in the Environment
+ * Base class for any object that can exist in the Environment. Entities and their shared pointer
+ * control blocks are allocated from the slab pools
+ *
+ * Neither the slab pools nor the handle table are locked, so Entities must be created and
+ * destroyed on a single thread. Handles may be resolved from other threads while none are
  */
-class Entity : public std::enable_shared_from_this<Entity> {
+class Entity {
 public:
     typedef std::shared_ptr<Entity> Ptr;
 
+    /**
+     * Non-owning reference to an Entity. Resolves to null once the Entity is destroyed. Copying and
+     * resolving a handle involves no reference counting
+     */
+    class Handle {
+    public:
+        /**
+         * Creates a handle that refers to nothing
+         */
+        Handle() : index(0), generation(0) {}
+
+        /**
+         * Returns the Entity referred to or null if it was destroyed
+         */
+        Entity* get() const;
+
+        explicit operator bool() const { return get() != nullptr; }
+        bool operator==(const Handle& handle) const { return index == handle.index && generation == handle.generation; }
+        bool operator!=(const Handle& handle) const { return !(*this == handle); }
+
+    private:
+        std::uint32_t index;
+        std::uint32_t generation;
+
+        Handle(std::uint32_t index, std::uint32_t generation) : index(index), generation(generation) {}
+
+        friend class Entity;
+    };
+
     /**
      * Creates an Entity
      * 
@@ -37,31 +74,111 @@ public:
         const sf::Vector2f& velocity, float mass, bool canMove, bool hasGravity, float gRange = -1
     );
 
+    /**
+     * Creates an Entity from its spec
+     */
+    static Ptr create(const EntitySpec& spec);
+
     /**
      * Creates an Entity from json data
      */
     static Ptr create(const JsonGroup& data);
 
-    virtual ~Entity() = default;
+    /**
+     * Returns the gravitational range used for the given mass when none is specified
+     */
+    static float defaultGravitationalRange(float mass);
+
+    virtual ~Entity();
+
+    static void* operator new(std::size_t size) { return SlabAllocator::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { SlabAllocator::deallocate(ptr, size); }
+
+    /**
+     * Returns a handle to this Entity
+     */
+    Handle getHandle() const;
 
     const std::string& getName() const;
+
+    /**
+     * Returns the axis aligned box containing the Entity at its current rotation
+     */
     sf::FloatRect getBoundingBox() const;
+
+    /**
+     * Returns true if the Entity collides as a circle rather than a box. Bodies with gravity are
+     * round
+     */
+    bool isRound() const;
+
+    /**
+     * Returns the circle used for round entities. For other entities this is the largest circle
+     * inside the box, used for swept tests
+     */
+    Circle getCollisionCircle() const;
+
+    /**
+     * Returns the box used for entities that are not round
+     */
+    OrientedBox getCollisionBox() const;
     float distanceToSquared(const sf::Vector2f& position) const;
 
     float getRotation() const;
+    void setRotation(float rotation);
     void applyRotation(float rate);
 
+    unsigned int getAnimationFrame() const;
+    void setAnimationFrame(unsigned int frame);
+
+    /**
+     * Advances the animation. Kept apart from update() so that animations can be skipped when
+     * nothing is rendered
+     */
+    void updateAnimation(float dt);
+
     const sf::Vector2f& getPosition() const;
     const sf::Vector2f& getVelocity() const;
+
+    /**
+     * Returns the position at the start of the last update
+     */
+    const sf::Vector2f& getPreviousPosition() const;
+
+    /**
+     * Returns true if the Entity can be moved by forces
+     */
+    bool isMovable() const;
+
+    /**
+     * Moves the Entity back to where it first touched a surface during the last update. Velocity
+     * into the surface is removed and the rest of the step is spent sliding along it
+     *
+     * \param toi Fraction of the last update at which the impact happened
+     * \param normal Unit normal of the surface at the impact
+     * \param dt Length of the last update
+     */
+    void resolveImpact(float toi, const sf::Vector2f& normal, float dt);
     float getMass() const;
 
     float getGravitationalRange() const;
     sf::Vector2f getGravitationalAcceleration(const sf::Vector2f& position) const;
-    sf::Vector2f getGravitationalAcceleration(Ptr entity) const;
+    sf::Vector2f getGravitationalAcceleration(const Entity& entity) const;
 
-    void applyGravityToEntity(Ptr entity);
-    Ptr currentParentBody() const;
+    /**
+     * Applies this Entity's gravity to the given Entity. The reference is not retained past the
+     * call, so callers iterating an owning container should pass the pointee rather than copying
+     * pointers
+     */
+    void applyGravityToEntity(Entity& entity);
 
+    /**
+     * Returns the Entity with the strongest gravitational pull on this one during the last update
+     */
+    Handle currentParentBody() const;
+
+    const EntityMotion& getMotion() const;
+    EntityMotion& getMotion();
     void changeMotionType(EntityMotion::Ptr motion);
     void applyForce(const sf::Vector2f& force);
     void applyAcceleration(const sf::Vector2f& acceleration);
@@ -74,12 +191,17 @@ public:
     /**
      * Renders to the target. Position is in pixels. sf::View should be used for camera
      */
-    void render(sf::RenderTarget& target);
+    void render(CountingRenderTarget& target);
 
 protected:
     Entity(const std::string& name, const std::string& animFile, const sf::Vector2f& position,
            const sf::Vector2f& velocity, float mass, bool canMove, bool hasGravity, float gRange = -1);
 
+    /**
+     * Wraps a newly created Entity in a pointer whose control block is also pooled
+     */
+    static Ptr makePtr(Entity* entity);
+
     /**
      * Called from update() for derived classes to implement custom functionality
      */
@@ -94,6 +216,7 @@ private:
     float rotationRate; //TODO - persistent rotation rate
 
     EntityMotion::Ptr motion;
+    sf::Vector2f previousPosition;
 
     const float mass;
     const float gravitationalRange, gRangeSqrd;
@@ -101,8 +224,11 @@ private:
     const bool canMove;
     const bool hasGravity;
 
-    Ptr parentBody;
-    AngularVectorF strongestGravity;
+    const Handle handle;
+    Handle parentBody;
+    float strongestGravity; // squared magnitude
+
+    static Handle acquireHandle(Entity* entity);
 };
 
 /**
@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <SFML/Graphics.hpp>
+#include <Util/SlabAllocator.hpp>
 
 class Entity;
 
@@ -13,6 +14,14 @@ class EntityMotion {
 public:
     typedef std::shared_ptr<EntityMotion> Ptr;
 
+    /**
+     * Concrete motion types. Used when saving and restoring state
+     */
+    enum Type {
+        Physics,
+        Orbital
+    };
+
     /**
      * Create the motion object from position
      */
@@ -20,6 +29,9 @@ public:
 
     virtual ~EntityMotion() = default;
 
+    static void* operator new(std::size_t size) { return SlabAllocator::allocate(size); }
+    static void operator delete(void* ptr, std::size_t size) { SlabAllocator::deallocate(ptr, size); }
+
     /**
      * Apply an acceleration
      */
@@ -30,6 +42,11 @@ public:
      */
     virtual void update(Entity* entity, float dt) = 0;
 
+    /**
+     * Returns the concrete type of the motion
+     */
+    virtual Type getType() const = 0;
+
     /**
      * Returns the position of the Entity
      */
@@ -45,7 +62,22 @@ public:
      */
     void setMotionEnabled(bool enabled) { canMove = enabled; }
 
+    /**
+     * Overrides the current position and velocity. Used by collision to undo penetration
+     */
+    void correct(const sf::Vector2f& position, const sf::Vector2f& velocity) {
+        setPosition(position);
+        setVelocity(velocity);
+    }
+
 protected:
+    /**
+     * Wraps a newly created motion in a pointer whose control block is also pooled
+     */
+    static Ptr makePtr(EntityMotion* motion) {
+        return Ptr(motion, std::default_delete<EntityMotion>(), PoolAllocator<EntityMotion>());
+    }
+
     void setPosition(const sf::Vector2f& p) { if (canMove) pos = p; }
     void setVelocity(const sf::Vector2f& v) { if (canMove) vel = v; }
 
@@ -0,0 +1,30 @@
+#ifndef ENTITYSPEC_HPP
+#define ENTITYSPEC_HPP
+
+#include <string>
+
+/**
+ * Plain description of an Entity as stored in environment files
+ */
+struct EntitySpec {
+    std::string name;
+    std::string gfx;
+    float x = 0, y = 0;
+    float vx = 0, vy = 0;
+    float mass = 0;
+    bool canMove = false;
+    bool hasGravity = false;
+    float gravityRange = -1;
+};
+
+inline bool operator==(const EntitySpec& a, const EntitySpec& b) {
+    return a.name == b.name && a.gfx == b.gfx && a.x == b.x && a.y == b.y && a.vx == b.vx && a.vy == b.vy &&
+           a.mass == b.mass && a.canMove == b.canMove && a.hasGravity == b.hasGravity &&
+           a.gravityRange == b.gravityRange;
+}
+
+inline bool operator!=(const EntitySpec& a, const EntitySpec& b) {
+    return !(a == b);
+}
+
+#endif
\ No newline at end of file
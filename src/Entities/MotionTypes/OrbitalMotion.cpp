@@ -13,21 +13,48 @@ bool isOrbitClockwise(float angle, const sf::Vector2f& velocity) {
 }
 }
 
-EntityMotion::Ptr OrbitalMotion::create(Entity::Ptr parentBody, Entity* satellite) {
-    return EntityMotion::Ptr(new OrbitalMotion(parentBody, satellite));
+EntityMotion::Ptr OrbitalMotion::create(const Entity& parentBody, Entity* satellite) {
+    return makePtr(new OrbitalMotion(parentBody, satellite));
 }
 
-OrbitalMotion::OrbitalMotion(Entity::Ptr parentBody, Entity* satellite)
+OrbitalMotion::OrbitalMotion(const Entity& parentBody, Entity* satellite)
 : EntityMotion(satellite->getPosition())
-, parentBody(parentBody)
+, parentBody(parentBody.getHandle())
 , elapsedTime(0)
-, radius(std::sqrt(parentBody->distanceToSquared(satellite->getPosition())))
-, orbitalVelocity(std::sqrt(Properties::GravitationalConstant * parentBody->getMass() / radius))
+, radius(std::sqrt(parentBody.distanceToSquared(satellite->getPosition())))
+, orbitalVelocity(std::sqrt(Properties::GravitationalConstant * parentBody.getMass() / radius))
 , period((radius * 2 * 3.1415926) / orbitalVelocity)
-, insertionAngle(AngularVectorF(satellite->getPosition()-parentBody->getPosition()).angle)
+, insertionAngle(AngularVectorF(satellite->getPosition()-parentBody.getPosition()).angle)
 , clockwise(isOrbitClockwise(insertionAngle, satellite->getVelocity()))
 {
-    setVelocity(getCurrentVelocity().toCartesian());
+    setVelocity(getCurrentVelocity(getRelativePosition()));
+}
+
+OrbitalMotion::OrbitalMotion(const Entity& parentBody, const Parameters& params)
+: EntityMotion(parentBody.getPosition())
+, parentBody(parentBody.getHandle())
+, elapsedTime(params.elapsedTime)
+, radius(params.radius)
+, orbitalVelocity(params.orbitalVelocity)
+, period(params.period)
+, insertionAngle(params.insertionAngle)
+, clockwise(params.clockwise)
+{
+    const sf::Vector2f relativePosition = getRelativePosition();
+    setPosition(parentBody.getPosition() + relativePosition);
+    setVelocity(getCurrentVelocity(relativePosition));
+}
+
+EntityMotion::Ptr OrbitalMotion::create(const Entity& parentBody, const Parameters& parameters) {
+    return makePtr(new OrbitalMotion(parentBody, parameters));
+}
+
+OrbitalMotion::Parameters OrbitalMotion::getParameters() const {
+    return {elapsedTime, radius, orbitalVelocity, period, insertionAngle, clockwise};
+}
+
+Entity::Handle OrbitalMotion::getParentBody() const {
+    return parentBody;
 }
 
 float OrbitalMotion::getCurrentAngle() const {
@@ -36,17 +63,27 @@ float OrbitalMotion::getCurrentAngle() const {
     return insertionAngle + passedOrbits * direction * 360;
 }
 
-AngularVectorF OrbitalMotion::getCurrentVelocity() const {
-    const float offset = clockwise ? 90 : -90;
-    return AngularVectorF(orbitalVelocity, getCurrentAngle() + offset);
+sf::Vector2f OrbitalMotion::getCurrentVelocity(const sf::Vector2f& relativePosition) const {
+    // Velocity is a quarter turn from the radius, so it comes from the same sine and cosine
+    const float scale = orbitalVelocity / radius;
+    if (clockwise)
+        return sf::Vector2f(-relativePosition.y, relativePosition.x) * scale;
+    return sf::Vector2f(relativePosition.y, -relativePosition.x) * scale;
 }
 
 sf::Vector2f OrbitalMotion::getRelativePosition() const {
-    return AngularVectorF(radius, getCurrentAngle()).toCartesian();
+    return CachedAngularVectorF(radius, getCurrentAngle()).cartesian();
 }
 
 void OrbitalMotion::update(Entity*, float dt) {
+    const Entity* parent = parentBody.get();
+    if (!parent) {
+        setPosition(getPosition() + getVelocity() * dt);
+        return;
+    }
+
     elapsedTime += dt;
-    setPosition(parentBody->getPosition() + getRelativePosition());
-    setVelocity(getCurrentVelocity().toCartesian());
+    const sf::Vector2f relativePosition = getRelativePosition();
+    setPosition(parent->getPosition() + relativePosition);
+    setVelocity(getCurrentVelocity(relativePosition));
 }
\ No newline at end of file
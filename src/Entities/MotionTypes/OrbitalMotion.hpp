@@ -10,9 +10,27 @@
 class OrbitalMotion : public EntityMotion {
 public:
     /**
-     * Creates a new motion object for the given parent and satellite
+     * Everything needed to recreate an orbit in progress
      */
-    static EntityMotion::Ptr create(Entity::Ptr parentBody, Entity* satellite);
+    struct Parameters {
+        float elapsedTime;
+        float radius;
+        float orbitalVelocity;
+        float period;
+        float insertionAngle;
+        bool clockwise;
+    };
+
+    /**
+     * Creates a new motion object for the given parent and satellite. The orbit stops following
+     * the parent if it is destroyed
+     */
+    static EntityMotion::Ptr create(const Entity& parentBody, Entity* satellite);
+
+    /**
+     * Recreates an orbit from its parameters. The satellite is placed on the orbit
+     */
+    static EntityMotion::Ptr create(const Entity& parentBody, const Parameters& parameters);
 
     virtual ~OrbitalMotion() = default;
 
@@ -23,8 +41,20 @@ public:
      */
     virtual void update(Entity* entity, float dt) override;
 
+    virtual Type getType() const override { return Orbital; }
+
+    /**
+     * Returns the parameters of the orbit
+     */
+    Parameters getParameters() const;
+
+    /**
+     * Returns the body being orbited
+     */
+    Entity::Handle getParentBody() const;
+
 private:
-    Entity::Ptr parentBody;
+    Entity::Handle parentBody;
     float elapsedTime;
 
     const float radius;
@@ -33,11 +63,12 @@ private:
     const float insertionAngle;
     const bool clockwise;
 
-    OrbitalMotion(Entity::Ptr parentBody, Entity* satellite);
+    OrbitalMotion(const Entity& parentBody, Entity* satellite);
+    OrbitalMotion(const Entity& parentBody, const Parameters& parameters);
 
     float getCurrentAngle() const;
     sf::Vector2f getRelativePosition() const;
-    AngularVectorF getCurrentVelocity() const;
+    sf::Vector2f getCurrentVelocity(const sf::Vector2f& relativePosition) const;
 };
 
 #endif
\ No newline at end of file
@@ -1,11 +1,11 @@
 #include <Entities/MotionTypes/PhysicsMotion.hpp>
 
 EntityMotion::Ptr PhysicsMotion::create(const sf::Vector2f& pos, const sf::Vector2f& vel) {
-    return EntityMotion::Ptr(new PhysicsMotion(pos, vel));
+    return makePtr(new PhysicsMotion(pos, vel));
 }
 
-EntityMotion::Ptr PhysicsMotion::create(Entity::Ptr entity) {
-    return EntityMotion::Ptr(new PhysicsMotion(entity->getPosition(), entity->getVelocity()));
+EntityMotion::Ptr PhysicsMotion::create(const Entity& entity) {
+    return makePtr(new PhysicsMotion(entity.getPosition(), entity.getVelocity()));
 }
 
 PhysicsMotion::PhysicsMotion(const sf::Vector2f& pos, const sf::Vector2f& vel)
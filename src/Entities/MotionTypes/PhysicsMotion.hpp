@@ -12,7 +12,7 @@ public:
     /**
      * Create the motion object for the given Entity's current position and velocity
      */
-    static EntityMotion::Ptr create(Entity::Ptr entity);
+    static EntityMotion::Ptr create(const Entity& entity);
 
     /**
      * Create the motion object from position and velocity
@@ -31,6 +31,8 @@ public:
      */
     virtual void update(Entity* entity, float dt) override;
 
+    virtual Type getType() const override { return Physics; }
+
 private:
     sf::Vector2f acceleration;
 
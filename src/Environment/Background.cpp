@@ -1,37 +1,96 @@
 #include <Environment/Background.hpp>
 #include <Environment/Backgrounds/ElementGeneratorFactory.hpp>
+#include <Util/Parallel.hpp>
+#include <Util/Profiler.hpp>
 #include <Util/Schemas.hpp>
 #include <iostream>
+#include <utility>
 
 void Background::load(const JsonGroup& data) {
-    if (!Schemas::backgroundSchema().validate(data, true)) {
+    BackgroundSpec newSpec;
+    if (!Schemas::backgroundBinding().load(data, newSpec, true)) {
         std::cerr << "Leaving background blank\n";
         return;
     }
+    load(newSpec);
+}
 
-    const JsonGroup& colorGroup = *data.getField("color")->getAsGroup();
-    color.r = *colorGroup.getField("red")->getAsNumeric();
-    color.g = *colorGroup.getField("green")->getAsNumeric();
-    color.b = *colorGroup.getField("blue")->getAsNumeric();
+void Background::load(const BackgroundSpec& newSpec) {
+    color.r = newSpec.color.red;
+    color.g = newSpec.color.green;
+    color.b = newSpec.color.blue;
 
-    const JsonList& egens = *data.getField("elements")->getAsList();
-    generators.reserve(egens.size());
-    for (unsigned int i = 0; i<egens.size(); ++i) {
-        BackgroundElementGenerator::Ptr gen = ElementGeneratorFactory::create(*egens[i].getAsGroup());
-        if (gen)
-            generators.push_back(gen);
+    std::vector<BackgroundElementGenerator::Ptr> newGenerators(newSpec.elements.size());
+    for (unsigned int i = 0; i<newSpec.elements.size(); ++i) {
+        for (unsigned int j = 0; j<spec.elements.size(); ++j) {
+            if (generators[j] && spec.elements[j] == newSpec.elements[i]) {
+                newGenerators[i].swap(generators[j]);
+                break;
+            }
+        }
+        if (!newGenerators[i])
+            newGenerators[i] = ElementGeneratorFactory::create(newSpec.elements[i]);
     }
+
+    spec = newSpec;
+    generators.swap(newGenerators);
 }
 
 void Background::update(const sf::FloatRect& region) {
+    PROFILE_ZONE("Background::update");
+
+    // Missing buckets of every generator are generated together so that a single generator with
+    // few buckets does not leave threads idle
+    std::vector<std::pair<BackgroundElementGenerator*, unsigned int> > jobs;
+    for (unsigned int i = 0; i<generators.size(); ++i) {
+        if (generators[i]) {
+            const unsigned int n = generators[i]->queueUpdate(region);
+            for (unsigned int j = 0; j<n; ++j)
+                jobs.emplace_back(generators[i].get(), j);
+        }
+    }
+
+    parallelFor(jobs.size(), [&jobs](unsigned int i) {
+        jobs[i].first->generatePending(jobs[i].second);
+    });
+
+    for (unsigned int i = 0; i<generators.size(); ++i) {
+        if (generators[i])
+            generators[i]->finishUpdate();
+    }
+}
+
+void Background::updateAnimations(float dt) {
+    for (const BackgroundElementGenerator::Ptr& generator : generators) {
+        if (generator)
+            generator->updateAnimation(dt);
+    }
+}
+
+std::vector<std::uint64_t> Background::getSeeds() const {
+    std::vector<std::uint64_t> seeds(generators.size(), 0);
+    for (unsigned int i = 0; i<generators.size(); ++i) {
+        if (generators[i])
+            seeds[i] = generators[i]->getSeed();
+    }
+    return seeds;
+}
+
+bool Background::setSeeds(const std::vector<std::uint64_t>& seeds) {
+    if (seeds.size() != generators.size())
+        return false;
     for (unsigned int i = 0; i<generators.size(); ++i) {
-        generators[i]->update(region);
+        if (generators[i])
+            generators[i]->setSeed(seeds[i]);
     }
+    return true;
 }
 
-void Background::render(sf::RenderTarget& target) {
+void Background::render(CountingRenderTarget& target) {
+    PROFILE_ZONE("Background::render");
     target.clear(color);
     for (unsigned int i = 0; i<generators.size(); ++i) {
-        generators[i]->render(target);
+        if (generators[i])
+            generators[i]->render(target);
     }
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define BACKGROUND_HPP
 
 #include <Environment/Backgrounds/BackgroundElementGenerator.hpp>
+#include <Environment/BackgroundSpec.hpp>
 #include <Util/JsonFile.hpp>
 
 /**
@@ -11,13 +12,35 @@ class Background {
 public:
     void load(const JsonGroup& data);
 
+    /**
+     * Loads the background from its spec. Generators whose spec is unchanged from the previous
+     * load are kept, along with the elements they have generated
+     */
+    void load(const BackgroundSpec& spec);
+
     void update(const sf::FloatRect& activeRegion);
 
-    void render(sf::RenderTarget& target);
+    /**
+     * Advances the animations of every element generator
+     */
+    void updateAnimations(float dt);
+
+    void render(CountingRenderTarget& target);
+
+    /**
+     * Returns the seed of each element generator, in spec order. Missing generators have seed 0
+     */
+    std::vector<std::uint64_t> getSeeds() const;
+
+    /**
+     * Restores generator seeds returned by getSeeds(). Returns false if the count does not match
+     */
+    bool setSeeds(const std::vector<std::uint64_t>& seeds);
 
 private:
     sf::Color color;
-    std::vector<BackgroundElementGenerator::Ptr> generators;
+    BackgroundSpec spec;
+    std::vector<BackgroundElementGenerator::Ptr> generators; // parallel to spec, may contain null
 };
 
 #endif
\ No newline at end of file
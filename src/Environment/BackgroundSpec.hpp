@@ -0,0 +1,82 @@
+#ifndef BACKGROUNDSPEC_HPP
+#define BACKGROUNDSPEC_HPP
+
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Plain description of a background element generator. The scale and positioning each have
+ * exactly one of their options set
+ */
+struct BackgroundElementSpec {
+    struct Pair {
+        float x = 0, y = 0;
+    };
+
+    struct Range {
+        bool preserveAR = false;
+        bool allowHFlip = false;
+        bool allowVFlip = false;
+        float minx = 0, miny = 0;
+        float maxx = 0, maxy = 0;
+    };
+
+    struct Random {
+        float density = 0;
+    };
+
+    struct Scale {
+        std::optional<Pair> fixed;
+        std::optional<Range> ranged;
+    };
+
+    struct Positioning {
+        std::optional<Random> random;
+        std::optional<Pair> fixedSpacing;
+        std::optional<Range> rangedSpacing;
+    };
+
+    std::string file;
+    Positioning positioning;
+    Scale scale;
+};
+
+inline bool operator==(const BackgroundElementSpec::Pair& a, const BackgroundElementSpec::Pair& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+inline bool operator==(const BackgroundElementSpec::Range& a, const BackgroundElementSpec::Range& b) {
+    return a.preserveAR == b.preserveAR && a.allowHFlip == b.allowHFlip && a.allowVFlip == b.allowVFlip &&
+           a.minx == b.minx && a.miny == b.miny && a.maxx == b.maxx && a.maxy == b.maxy;
+}
+
+inline bool operator==(const BackgroundElementSpec::Random& a, const BackgroundElementSpec::Random& b) {
+    return a.density == b.density;
+}
+
+inline bool operator==(const BackgroundElementSpec& a, const BackgroundElementSpec& b) {
+    return a.file == b.file &&
+           a.scale.fixed == b.scale.fixed && a.scale.ranged == b.scale.ranged &&
+           a.positioning.random == b.positioning.random &&
+           a.positioning.fixedSpacing == b.positioning.fixedSpacing &&
+           a.positioning.rangedSpacing == b.positioning.rangedSpacing;
+}
+
+inline bool operator!=(const BackgroundElementSpec& a, const BackgroundElementSpec& b) {
+    return !(a == b);
+}
+
+/**
+ * Plain description of a Background
+ */
+struct BackgroundSpec {
+    struct Color {
+        float red = 0, green = 0, blue = 0;
+    };
+
+    Color color;
+    std::vector<BackgroundElementSpec> elements;
+};
+
+#endif
\ No newline at end of file
@@ -1,6 +1,6 @@
 #include <Environment/Backgrounds/BackgroundElementGenerator.hpp>
+#include <Util/Parallel.hpp>
 #include <Util/Timer.hpp>
-#include <Util/Util.hpp>
 #include <Properties.hpp>
 #include <cmath>
 #include <iostream>
@@ -11,11 +11,16 @@ constexpr float cleanPeriod       = 10.0;
 constexpr int   bucketSize        = 1000;
 constexpr int   maxRenderBuckets  = 10;
 constexpr int   lowRenderInc      = 4;
+
+std::uint64_t makeSeed() {
+    Random& rng = Random::local();
+    return (static_cast<std::uint64_t>(rng.next()) << 32) | rng.next();
+}
 }
 
 bool BackgroundElementGenerator::BucketKeyCmp::operator()(
         const BackgroundElementGenerator::BucketKey& lhs,
-        const BackgroundElementGenerator::BucketKey& rhs) {
+        const BackgroundElementGenerator::BucketKey& rhs) const {
     const int skewedLeft = lhs.x * keySkew + lhs.y;
     const int skewedRight = rhs.x * keySkew + rhs.y;
     return skewedLeft < skewedRight;
@@ -58,7 +63,9 @@ std::vector<BackgroundElementGenerator::BucketKey>
 
 BackgroundElementGenerator::BackgroundElementGenerator(const std::string& file, bool preserveAR,
     const sf::Vector2f& minScale, const sf::Vector2f& maxScale)
-: gfx(Properties::EnvironmentImagePath, Properties::EnvironmentAnimPath, file, false)
+: seed(makeSeed())
+, lastCleanTime(0)
+, gfx(Properties::EnvironmentImagePath, Properties::EnvironmentAnimPath, file, false)
 , preserveAspectRatio(preserveAR)
 , canFlipH(minScale.x < 0)
 , canFlipV(minScale.y < 0)
@@ -69,14 +76,41 @@ BackgroundElementGenerator::BackgroundElementGenerator(const std::string& file,
 }
 
 void BackgroundElementGenerator::update(const sf::FloatRect& region) {
-    const std::vector<BucketKey> keys = BucketKey::gen(region);
-    for (unsigned int i = 0; i<keys.size(); ++i) {
-        if (buckets.find(keys[i]) == buckets.end())
-            buckets[keys[i]] = generate(keys[i]);
+    parallelFor(queueUpdate(region), [this](unsigned int i) {
+        generatePending(i);
+    });
+    finishUpdate();
+}
+
+unsigned int BackgroundElementGenerator::queueUpdate(const sf::FloatRect& region) {
+    activeKeys = BucketKey::gen(region);
+    pendingKeys.clear();
+    for (unsigned int i = 0; i<activeKeys.size(); ++i) {
+        if (buckets.find(activeKeys[i]) == buckets.end())
+            pendingKeys.push_back(activeKeys[i]);
     }
+    pendingBuckets.clear();
+    pendingBuckets.resize(pendingKeys.size());
+    return pendingKeys.size();
+}
+
+void BackgroundElementGenerator::generatePending(unsigned int i) {
+    const BucketKey& key = pendingKeys[i];
+    const std::uint64_t stream = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(key.x)) << 32) |
+                                 static_cast<std::uint32_t>(key.y);
+    Random rng(seed, stream);
+    pendingBuckets[i] = generate(key, rng);
+}
+
+void BackgroundElementGenerator::finishUpdate() {
+    for (unsigned int i = 0; i<pendingKeys.size(); ++i)
+        buckets.emplace(pendingKeys[i], std::move(pendingBuckets[i]));
+    pendingKeys.clear();
+    pendingBuckets.clear();
+
     if (Timer::get().timeElapsedSeconds() - lastCleanTime > cleanPeriod) {
         lastCleanTime = Timer::get().timeElapsedSeconds();
-        cleanBuckets(keys);
+        cleanBuckets(activeKeys);
     }
 }
 
@@ -88,23 +122,38 @@ void BackgroundElementGenerator::cleanBuckets(const std::vector<BucketKey>& keys
     }
 }
 
+std::uint64_t BackgroundElementGenerator::getSeed() const {
+    return seed;
+}
+
+void BackgroundElementGenerator::setSeed(std::uint64_t s) {
+    if (s != seed) {
+        seed = s;
+        buckets.clear();
+    }
+}
+
 const sf::Vector2f& BackgroundElementGenerator::getElementSize() const {
     return maxGfxSize;
 }
 
-sf::Vector2f BackgroundElementGenerator::getElementScale() const {
-    float x = randomFloat(minScale.x, maxScale.x);
-    if (canFlipH && randomFloat(0, 1) <= 0.5)
+sf::Vector2f BackgroundElementGenerator::getElementScale(Random& rng) const {
+    float x = rng.nextFloat(minScale.x, maxScale.x);
+    if (canFlipH && rng.chance(0.5))
         x *= -1;
-    float y = randomFloat(minScale.x, minScale.y);
-    if (canFlipV && randomFloat(0, 1) <= 0.5)
+    float y = rng.nextFloat(minScale.y, maxScale.y);
+    if (canFlipV && rng.chance(0.5))
         y *= -1;
     if (preserveAspectRatio)
         y = x;
     return {x, y};
 }
 
-void BackgroundElementGenerator::render(sf::RenderTarget& target) {
+void BackgroundElementGenerator::updateAnimation(float dt) {
+    gfx.update(dt);
+}
+
+void BackgroundElementGenerator::render(CountingRenderTarget& target) {
     const sf::FloatRect region(
         target.getView().getCenter() - target.getView().getSize() / 2.0f,
         target.getView().getSize()
@@ -2,18 +2,57 @@
 #define BACKGROUNDELEMENTGENERATOR_HPP
 
 #include <Media/GraphicsWrapper.hpp>
+#include <Util/Random.hpp>
+#include <cstdint>
 #include <memory>
 
 /**
- * Base generator class for background elements
+ * Base generator class for background elements. Elements are generated in square buckets. Each
+ * bucket is generated from its own random stream, derived from the generator seed and the bucket
+ * position, so buckets can be generated in parallel and regenerate identically after being cleaned
  */
 class BackgroundElementGenerator {
 public:
     typedef std::shared_ptr<BackgroundElementGenerator> Ptr;
 
+    /**
+     * Generates any missing buckets in the region, in parallel
+     */
     void update(const sf::FloatRect& region);
 
-    void render(sf::RenderTarget& target);
+    /**
+     * Finds the buckets in the region that need generating and returns how many there are. Used
+     * with generatePending() and finishUpdate() to generate buckets of several generators together
+     */
+    unsigned int queueUpdate(const sf::FloatRect& region);
+
+    /**
+     * Generates the i'th bucket found by queueUpdate(). Safe to call from multiple threads for
+     * different buckets
+     */
+    void generatePending(unsigned int i);
+
+    /**
+     * Stores the generated buckets and cleans up those no longer in use
+     */
+    void finishUpdate();
+
+    /**
+     * Advances the animation shared by all elements
+     */
+    void updateAnimation(float dt);
+
+    void render(CountingRenderTarget& target);
+
+    /**
+     * Returns the seed that buckets are generated from
+     */
+    std::uint64_t getSeed() const;
+
+    /**
+     * Changes the seed. Generated buckets are discarded so that they regenerate from the new seed
+     */
+    void setSeed(std::uint64_t seed);
 
 protected:
     struct Element {
@@ -27,11 +66,12 @@ protected:
         const sf::Vector2f& minScale, const sf::Vector2f& maxScale);
 
     /**
-     * Custom generators supply their logic here
+     * Custom generators supply their logic here. Called from worker threads, so implementations
+     * may only read generator state and must draw random numbers from the given generator
      */
-    virtual ElementBucket generate(const sf::FloatRect& region) = 0;
+    virtual ElementBucket generate(const sf::FloatRect& region, Random& rng) const = 0;
 
-    sf::Vector2f getElementScale() const;
+    sf::Vector2f getElementScale(Random& rng) const;
     const sf::Vector2f& getElementSize() const;
 
 private:
@@ -46,11 +86,15 @@ private:
         operator sf::FloatRect() const;
     };
     struct BucketKeyCmp {
-        bool operator()(const BucketKey& lhs, const BucketKey& rhs);
+        bool operator()(const BucketKey& lhs, const BucketKey& rhs) const;
     };
 
+    std::uint64_t seed;
     float lastCleanTime;
     std::map<BucketKey, ElementBucket, BucketKeyCmp> buckets;
+    std::vector<BucketKey> activeKeys;
+    std::vector<BucketKey> pendingKeys;
+    std::vector<ElementBucket> pendingBuckets; // parallel to pendingKeys
 
     GraphicsWrapper gfx;
     const bool preserveAspectRatio;
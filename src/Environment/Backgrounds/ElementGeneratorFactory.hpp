@@ -2,10 +2,10 @@
 #define ELEMENTGENERATORFACTORY_HPP
 
 #include <Environment/Backgrounds/BackgroundElementGenerator.hpp>
-#include <Util/JsonFile.hpp> //TODO - refactor json and all file layouts and includes
+#include <Environment/BackgroundSpec.hpp>
 
 struct ElementGeneratorFactory {
-    static BackgroundElementGenerator::Ptr create(const JsonGroup& data);
+    static BackgroundElementGenerator::Ptr create(const BackgroundElementSpec& spec);
 };
 
 #endif
\ No newline at end of file
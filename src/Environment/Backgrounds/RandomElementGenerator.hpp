@@ -12,7 +12,7 @@ class RandomElementGenerator : public BackgroundElementGenerator {
     RandomElementGenerator(const std::string& gfx, float density, bool preserveAR,
         const sf::Vector2f& minScale, const sf::Vector2f& maxScale);
 
-    virtual BackgroundElementGenerator::ElementBucket generate(const sf::FloatRect& region) override;
+    virtual BackgroundElementGenerator::ElementBucket generate(const sf::FloatRect& region, Random& rng) const override;
 
 private:
     const float density;
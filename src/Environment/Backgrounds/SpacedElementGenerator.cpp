@@ -1,9 +1,7 @@
 #include <Environment/Backgrounds/SpacedElementGenerator.hpp>
-#include <Util/Util.hpp>
+#include <algorithm>
 #include <cmath>
 
-#include <iostream>
-
 SpacedElementGenerator::SpacedElementGenerator(
         const std::string& file, bool preserveAR,
         const sf::Vector2f& minScale, const sf::Vector2f& maxScale,
@@ -13,7 +11,7 @@ SpacedElementGenerator::SpacedElementGenerator(
 , maxSpace(maxSpace) {}
 
 BackgroundElementGenerator::ElementBucket SpacedElementGenerator::generate(
-                                                const sf::FloatRect& region) {
+                                                const sf::FloatRect& region, Random& rng) const {
     const sf::Vector2f avgSpace = (maxSpace+minSpace)/2.0f;
     const sf::Vector2f avgSize = avgSpace + getElementSize();
     const sf::Vector2f offset = {
@@ -26,18 +24,16 @@ BackgroundElementGenerator::ElementBucket SpacedElementGenerator::generate(
     };
 
     BackgroundElementGenerator::ElementBucket elements;
+    elements.reserve(std::max(n.x, 0) * std::max(n.y, 0));
 
     const float halfY = (maxSpace.y - minSpace.y) / 2.0f;
     float x = region.left + offset.x;
     float y = region.top + offset.y;
     for (int cy = 0; cy<n.y; ++cy) {
         for (int cx = 0; cx<n.x; ++cx) {
-            const float ox = randomFloat(minSpace.x, maxSpace.x);
-            const float oy = randomFloat(minSpace.y, maxSpace.y) - halfY;
-            elements.push_back({
-                sf::Vector2f(x,y+oy),
-                getElementScale()
-            });
+            const float ox = rng.nextFloat(minSpace.x, maxSpace.x);
+            const float oy = rng.nextFloat(minSpace.y, maxSpace.y) - halfY;
+            elements.emplace_back(sf::Vector2f(x,y+oy), getElementScale(rng));
             x += getElementSize().x + ox;
         }
         y += avgSize.y;
@@ -13,7 +13,7 @@ class SpacedElementGenerator : public BackgroundElementGenerator {
         const sf::Vector2f& minScale, const sf::Vector2f& maxScale,
         const sf::Vector2f& minSpace, const sf::Vector2f& maxSpace);
 
-    virtual BackgroundElementGenerator::ElementBucket generate(const sf::FloatRect& region) override;
+    virtual BackgroundElementGenerator::ElementBucket generate(const sf::FloatRect& region, Random& rng) const override;
 
 private:
     const sf::Vector2f minSpace;
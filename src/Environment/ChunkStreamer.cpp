@@ -0,0 +1,224 @@
+#include <Environment/ChunkStreamer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <Properties.hpp>
+
+ChunkStreamer::ChunkStreamer()
+: chunkSize(0)
+, loadRadius(Properties::ScreenWidth * 2)
+, unloadRadius(Properties::ScreenWidth * 3)
+, runner(&ChunkStreamer::loader, this)
+, running(false)
+, failed(false)
+, synchronous(false) {}
+
+ChunkStreamer::~ChunkStreamer() {
+    close();
+}
+
+void ChunkStreamer::open(const std::string& file, EnvironmentFormat::ChunkTable&& table) {
+    close();
+
+    filename = file;
+    chunkSize = table.chunkSize;
+    chunks.resize(table.chunks.size());
+    for (unsigned int i = 0; i < table.chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+        chunk.record = table.chunks[i];
+        chunk.state = Unloaded;
+
+        // The proxy reaches as far as the furthest member could
+        const float gRange = chunk.record.radius + Entity::defaultGravitationalRange(chunk.record.mass);
+        chunk.gRangeSqrd = chunk.record.mass > 0 ? gRange * gRange : 0;
+    }
+
+    if (!synchronous) {
+        running = true;
+        runner.launch();
+    }
+}
+
+void ChunkStreamer::close(std::vector<Entity::Ptr>* removed) {
+    stopLoader();
+    if (removed) {
+        for (const Chunk& chunk : chunks)
+            removed->insert(removed->end(), chunk.entities.begin(), chunk.entities.end());
+    }
+    requests.clear();
+    results.clear();
+    chunks.clear();
+    filename.clear();
+    failed = false;
+}
+
+bool ChunkStreamer::isOpen() const {
+    return !chunks.empty();
+}
+
+void ChunkStreamer::setRadius(float load, float unload) {
+    loadRadius = load;
+    unloadRadius = std::max(load, unload);
+}
+
+void ChunkStreamer::setSynchronous(bool sync) {
+    if (sync == synchronous)
+        return;
+    synchronous = sync;
+
+    // Requests still queued are picked up by whichever side reads from now on
+    if (synchronous)
+        stopLoader();
+    else if (isOpen() && !failed) {
+        running = true;
+        runner.launch();
+    }
+}
+
+void ChunkStreamer::update(const sf::Vector2f& focus, std::vector<Entity::Ptr>& added, std::vector<Entity::Ptr>& removed) {
+    std::vector<Result> ready;
+    lock.lock();
+    ready.swap(results);
+
+    // Nothing will answer requests any more, so leave the chunks to their proxies
+    if (failed) {
+        for (unsigned int i : requests)
+            chunks[i].state = Unloaded;
+        requests.clear();
+    }
+
+    const std::size_t queued = requests.size();
+    for (unsigned int i = 0; i < chunks.size(); ++i) {
+        Chunk& chunk = chunks[i];
+        const float distance = distanceToChunk(chunk, focus);
+        if (chunk.state == Unloaded && distance <= loadRadius && !failed) {
+            chunk.state = Requested;
+            requests.push_back(i);
+        }
+        else if (chunk.state != Unloaded && distance > unloadRadius) {
+            if (chunk.state == Requested)
+                requests.erase(std::remove(requests.begin(), requests.end(), i), requests.end());
+            chunk.state = Unloaded;
+            removed.insert(removed.end(), chunk.entities.begin(), chunk.entities.end());
+            chunk.entities.clear();
+        }
+    }
+    const bool wakeLoader = requests.size() > queued;
+    lock.unlock();
+    if (wakeLoader)
+        wake.notify_one();
+
+    // Read right away so that chunks arrive on the tick they were requested
+    if (synchronous)
+        loadRequests(ready);
+
+    for (const Result& result : ready) {
+        Chunk& chunk = chunks[result.chunk];
+        // Released while loading
+        if (chunk.state != Requested)
+            continue;
+
+        chunk.state = Loaded;
+        chunk.entities.reserve(result.entities.size());
+        for (const EntitySpec& spec : result.entities)
+            chunk.entities.push_back(Entity::create(spec));
+        added.insert(added.end(), chunk.entities.begin(), chunk.entities.end());
+    }
+}
+
+sf::Vector2f ChunkStreamer::getProxyAcceleration(const sf::Vector2f& position) const {
+    sf::Vector2f acceleration(0, 0);
+    for (const Chunk& chunk : chunks) {
+        if (chunk.state == Loaded || chunk.gRangeSqrd <= 0)
+            continue;
+
+        const float dx = chunk.record.centerX - position.x;
+        const float dy = chunk.record.centerY - position.y;
+        const float distSqrd = dx*dx + dy*dy;
+        if (distSqrd > chunk.gRangeSqrd || distSqrd <= 0)
+            continue;
+
+        // Inside the chunk the mass is spread out, so cap the pull at its edge
+        const float minDist = std::max(chunk.record.radius, 1.0f);
+        const float accel = Properties::GravitationalConstant * chunk.record.mass / std::max(distSqrd, minDist*minDist);
+        const float dist = std::sqrt(distSqrd);
+        acceleration.x += accel * dx / dist;
+        acceleration.y += accel * dy / dist;
+    }
+    return acceleration;
+}
+
+void ChunkStreamer::loader() {
+    std::ifstream input(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!input.good()) {
+        std::cerr << "Failed to open environment for streaming: " << filename << std::endl;
+        // Set under the lock so that update() cannot queue a request after checking the flag
+        std::lock_guard<std::mutex> guard(lock);
+        failed = true;
+        return;
+    }
+
+    while (true) {
+        Result result;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this]() { return !running || !requests.empty(); });
+            if (!running)
+                break;
+            result.chunk = requests.front();
+            requests.pop_front();
+        }
+
+        // Chunk records are not modified while the thread runs
+        if (!EnvironmentFormat::loadChunk(input, chunks[result.chunk].record, result.entities))
+            result.entities.clear();
+
+        lock.lock();
+        results.push_back(std::move(result));
+        lock.unlock();
+    }
+}
+
+void ChunkStreamer::stopLoader() {
+    if (!running)
+        return;
+
+    lock.lock();
+    running = false;
+    lock.unlock();
+    wake.notify_one();
+    runner.wait();
+}
+
+void ChunkStreamer::loadRequests(std::vector<Result>& ready) {
+    if (requests.empty())
+        return;
+
+    std::ifstream input(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!input.good()) {
+        std::cerr << "Failed to open environment for streaming: " << filename << std::endl;
+        failed = true;
+        for (unsigned int i : requests)
+            chunks[i].state = Unloaded;
+        requests.clear();
+        return;
+    }
+    while (!requests.empty()) {
+        Result result;
+        result.chunk = requests.front();
+        requests.pop_front();
+        if (!EnvironmentFormat::loadChunk(input, chunks[result.chunk].record, result.entities))
+            result.entities.clear();
+        ready.push_back(std::move(result));
+    }
+}
+
+float ChunkStreamer::distanceToChunk(const Chunk& chunk, const sf::Vector2f& position) const {
+    const float left = chunk.record.x * chunkSize;
+    const float top = chunk.record.y * chunkSize;
+    const float dx = std::max(std::max(left - position.x, position.x - (left + chunkSize)), 0.0f);
+    const float dy = std::max(std::max(top - position.y, position.y - (top + chunkSize)), 0.0f);
+    return std::sqrt(dx*dx + dy*dy);
+}
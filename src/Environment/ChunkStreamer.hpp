@@ -0,0 +1,140 @@
+#ifndef CHUNKSTREAMER_HPP
+#define CHUNKSTREAMER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SFML/System.hpp>
+
+#include <Entities/Entity.hpp>
+#include <Environment/EnvironmentFormat.hpp>
+
+/**
+ * Streams the entity chunks of a compiled environment in and out around a focus point. Chunk data
+ * is read on a background thread and the entities are created on the updating thread once ready.
+ * Chunks that are not loaded are approximated by a single point mass for gravity
+ *
+ * When the loaded chunks must only depend on the simulation, such as in recorded or networked
+ * games, the streamer can be made synchronous. Chunks are then read in update() as soon as they
+ * are requested
+ *
+ * Entities in chunks are recreated from the file each time their chunk is loaded, so chunks only
+ * hold static bodies such as planets. Movable entities are kept in the main entity table
+ *
+ * If the file cannot be opened for streaming the streamer stops requesting chunks, and chunks that
+ * are not loaded keep contributing gravity through their proxies
+ */
+class ChunkStreamer {
+public:
+    /**
+     * Creates an empty streamer
+     */
+    ChunkStreamer();
+
+    /**
+     * Stops the loading thread
+     */
+    ~ChunkStreamer();
+
+    /**
+     * Starts streaming from the given compiled environment. Stops any previous streaming
+     *
+     * \param file The path of the compiled environment
+     * \param table The chunk table loaded from the file
+     */
+    void open(const std::string& file, EnvironmentFormat::ChunkTable&& table);
+
+    /**
+     * Stops streaming and releases all chunks
+     *
+     * \param removed Optionally receives the entities of the chunks that were loaded
+     */
+    void close(std::vector<Entity::Ptr>* removed = nullptr);
+
+    /**
+     * Returns true if there is a file being streamed from
+     */
+    bool isOpen() const;
+
+    /**
+     * Sets the distances from the focus within which chunks are loaded and beyond which they are
+     * unloaded. The unload distance should be larger to avoid thrashing on chunk borders
+     */
+    void setRadius(float loadRadius, float unloadRadius);
+
+    /**
+     * Sets whether chunks are read on the calling thread within update() instead of in the
+     * background. Synchronous streaming makes the entity set depend only on the focus path
+     */
+    void setSynchronous(bool synchronous);
+
+    /**
+     * Requests chunks near the focus and releases distant ones
+     *
+     * \param focus The position to stream around, typically the player
+     * \param added Receives the entities of chunks that finished loading
+     * \param removed Receives the entities of chunks that were released
+     */
+    void update(const sf::Vector2f& focus, std::vector<Entity::Ptr>& added, std::vector<Entity::Ptr>& removed);
+
+    /**
+     * Returns the gravitational acceleration at the position from all chunks that are not loaded
+     */
+    sf::Vector2f getProxyAcceleration(const sf::Vector2f& position) const;
+
+private:
+    enum State {
+        Unloaded,
+        Requested,
+        Loaded
+    };
+
+    struct Chunk {
+        EnvironmentFormat::Chunk record;
+        State state;
+        float gRangeSqrd;
+        std::vector<Entity::Ptr> entities;
+    };
+
+    struct Result {
+        unsigned int chunk;
+        std::vector<EntitySpec> entities;
+    };
+
+    std::string filename;
+    float chunkSize;
+    float loadRadius, unloadRadius;
+    std::vector<Chunk> chunks;
+
+    sf::Thread runner;
+    std::mutex lock;
+    std::condition_variable wake;
+    std::atomic<bool> running;
+    std::atomic<bool> failed;
+    bool synchronous;
+    std::deque<unsigned int> requests;
+    std::vector<Result> results;
+
+    /**
+     * Runs on a separate thread and reads requested chunks
+     */
+    void loader();
+
+    /**
+     * Stops and joins the loading thread if it is running
+     */
+    void stopLoader();
+
+    /**
+     * Reads every requested chunk on the calling thread
+     */
+    void loadRequests(std::vector<Result>& ready);
+
+    float distanceToChunk(const Chunk& chunk, const sf::Vector2f& position) const;
+};
+
+#endif
\ No newline at end of file
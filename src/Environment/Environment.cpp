@@ -1,16 +1,28 @@
 #include <Environment/Environment.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <unordered_map>
 #include <Properties.hpp>
 #include <Entities/ControllableEntity.hpp>
+#include <Entities/MotionTypes/OrbitalMotion.hpp>
+#include <Entities/MotionTypes/PhysicsMotion.hpp>
+#include <Environment/EnvironmentFormat.hpp>
 #include <Util/JsonFile.hpp>
+#include <Util/Util.hpp>
+#include <Util/Profiler.hpp>
 #include <Util/Schemas.hpp>
 
-Environment::Environment() {
+Environment::Environment()
+: localPlayer(0)
+, raceTime(0)
+, animationsEnabled(true)
+, playerTrack(GhostTrack::create()) {
     camera.setSize(Properties::ScreenWidth, Properties::ScreenHeight);
     victoryRegion = {0, 0, 800, 100};
-    player = ControllableEntity::createPlayer({250, 800}, {0, 0});
-    entities.push_back(player);
+    createPlayer({250, 800});
     entities.push_back(Entity::create(
         "Earth", "Planets/earth.anim", {500, 500},
         {0, 0}, 10000, false, true
@@ -23,61 +35,214 @@ Environment::Environment() {
     camera.zoom(0.5f);
 }
 
-Environment::Environment(const std::string& file) {
-    JsonFile input(Properties::EnvironmentFilePath+file);
-    if (!Schemas::environmentFileSchema().validate(input, true)) {
+Environment::Environment(const std::string& file)
+: filename(Properties::EnvironmentFilePath+file)
+, localPlayer(0)
+, raceTime(0)
+, animationsEnabled(true)
+, playerTrack(GhostTrack::create()) {
+    EnvironmentSpec spec;
+    EnvironmentFormat::ChunkTable chunks;
+    if (!readFile(spec, chunks)) {
         std::cerr << "Leaving environment empty on failed load" << std::endl;
-        player = ControllableEntity::createPlayer({0, 0}, {0, 0});
-        entities.push_back(player);
+        createPlayer({0, 0});
         return;
     }
-    const JsonGroup& data = input.getRoot();
+    load(spec);
 
-    name = *data.getField("name")->getAsString();
-    victoryRegion.top = *data.getField("winZone")->getAsGroup()->getField("top")->getAsNumeric();
-    victoryRegion.left = *data.getField("winZone")->getAsGroup()->getField("left")->getAsNumeric();
-    victoryRegion.width = *data.getField("winZone")->getAsGroup()->getField("width")->getAsNumeric();
-    victoryRegion.height = *data.getField("winZone")->getAsGroup()->getField("height")->getAsNumeric();
+    if (!chunks.chunks.empty())
+        streamer.open(filename, std::move(chunks));
+}
+
+Environment::Environment(const EnvironmentSpec& spec)
+: localPlayer(0)
+, raceTime(0)
+, animationsEnabled(true)
+, playerTrack(GhostTrack::create()) {
+    load(spec);
+}
+
+const std::string& Environment::getFilename() const {
+    return filename;
+}
+
+void Environment::reload() {
+    if (filename.empty())
+        return;
+
+    EnvironmentSpec spec;
+    EnvironmentFormat::ChunkTable chunks;
+    if (!readFile(spec, chunks)) {
+        std::cerr << "Keeping current environment on failed reload" << std::endl;
+        return;
+    }
+
+    // Streamed chunks are reopened against the new file
+    if (streamer.isOpen()) {
+        std::vector<Entity::Ptr> removed;
+        streamer.close(&removed);
+        removeEntities(removed);
+    }
+
+    load(spec);
+    playerStatus.assign(players.size(), Playing);
+
+    if (!chunks.chunks.empty())
+        streamer.open(filename, std::move(chunks));
+    std::cout << "Reloaded environment " << filename << std::endl;
+}
+
+bool Environment::readFile(EnvironmentSpec& spec, EnvironmentFormat::ChunkTable& chunks) const {
+    if (EnvironmentFormat::isCompiled(filename))
+        return EnvironmentFormat::load(filename, spec, &chunks);
+
+    JsonFile input(filename);
+    return Schemas::environmentFileBinding().load(input.getRoot(), spec, true);
+}
+
+void Environment::load(const EnvironmentSpec& spec) {
+    name = spec.name;
+    victoryRegion.top = spec.winZone.top;
+    victoryRegion.left = spec.winZone.left;
+    victoryRegion.width = spec.winZone.width;
+    victoryRegion.height = spec.winZone.height;
     bounds.left = bounds.top = 0;
-    bounds.width = *data.getField("width")->getAsNumeric();
-    bounds.height = *data.getField("height")->getAsNumeric();
-
-    const JsonGroup& spawn = *data.getField("playerSpawn")->getAsGroup();
-    player = ControllableEntity::createPlayer(
-        {
-            *spawn.getField("x")->getAsNumeric(),
-            *spawn.getField("y")->getAsNumeric()
-        },
-        {0, 0}
-    );
-    entities.push_back(player);
+    bounds.width = spec.width;
+    bounds.height = spec.height;
 
-    const JsonList& entityList = *data.getField("entities")->getAsList();
-    for (unsigned int i = 0; i<entityList.size(); ++i) {
-        entities.push_back(Entity::create(*entityList[i].getAsGroup()));
+    if (players.empty()) {
+        entities.reserve(spec.entities.size() + 1);
+        createPlayer({spec.playerSpawn.x, spec.playerSpawn.y});
     }
 
-    background.load(*data.getField("background")->getAsGroup());
+    // Entities with an unchanged spec are kept along with their state. Matched by name so that
+    // reordering the file does not recreate everything
+    std::unordered_map<std::string, std::vector<unsigned int> > previous;
+    for (unsigned int i = 0; i<entitySpecs.size(); ++i)
+        previous[entitySpecs[i].name].push_back(i);
+
+    std::vector<Entity::Ptr> newEntities(spec.entities.size());
+    std::vector<Entity::Ptr> added;
+    for (unsigned int i = 0; i<spec.entities.size(); ++i) {
+        auto match = previous.find(spec.entities[i].name);
+        if (match != previous.end()) {
+            for (unsigned int& j : match->second) {
+                if (specEntities[j] && entitySpecs[j] == spec.entities[i]) {
+                    newEntities[i].swap(specEntities[j]);
+                    break;
+                }
+            }
+        }
+        if (!newEntities[i]) {
+            newEntities[i] = Entity::create(spec.entities[i]);
+            added.push_back(newEntities[i]);
+        }
+    }
+
+    // Anything left over was changed or removed
+    std::vector<Entity::Ptr> removed;
+    for (const Entity::Ptr& entity : specEntities) {
+        if (entity)
+            removed.push_back(entity);
+    }
+    removeEntities(removed);
+    entities.insert(entities.end(), added.begin(), added.end());
+
+    entitySpecs = spec.entities;
+    specEntities.swap(newEntities);
+
+    background.load(spec.background);
+}
+
+void Environment::createPlayer(const sf::Vector2f& spawn) {
+    players.push_back(ControllableEntity::createPlayer(spawn, {0, 0}));
+    playerStatus.push_back(Playing);
+    entities.push_back(players.back());
+}
+
+void Environment::removeEntities(std::vector<Entity::Ptr>& removed) {
+    if (removed.empty())
+        return;
+
+    std::sort(removed.begin(), removed.end());
+    entities.erase(
+        std::remove_if(entities.begin(), entities.end(), [&removed](const Entity::Ptr& entity) {
+            return std::binary_search(removed.begin(), removed.end(), entity);
+        }),
+        entities.end()
+    );
 }
 
 void Environment::update(float dt) {
+    PROFILE_ZONE("Environment::update");
+
     const sf::FloatRect region(
         camera.getCenter() - camera.getSize()/2.0f,
         camera.getSize()
     );
     background.update(region);
-    for (Entity::Ptr entity : entities) {
-        for (Entity::Ptr gravEnt : entities) {
-            gravEnt->applyGravityToEntity(entity);
+    updateStreaming();
+
+    const bool playing = playerStatus[localPlayer] == Playing;
+
+    // Entities are only borrowed for the tick, so iterate by reference to avoid refcounting
+    // Each entity moves right after its gravity is summed, so later entities see the ones before
+    // them already moved. Both are timed as one zone to keep that order
+    {
+        PROFILE_ZONE("Gravity and motion");
+        for (const Entity::Ptr& entity : entities) {
+            for (const Entity::Ptr& gravEnt : entities) {
+                gravEnt->applyGravityToEntity(*entity);
+            }
+            if (streamer.isOpen())
+                entity->applyAcceleration(streamer.getProxyAcceleration(entity->getPosition()));
+            entity->update(dt);
         }
-        entity->update(dt);
     }
+    {
+        PROFILE_ZONE("Collision");
+        updateBroadphase();
+        resolveTunneling(dt);
+        updateStatus();
+    }
+
+    // Sampled after the step so that the track ends exactly at the finish
+    raceTime += dt;
+    if (playing) {
+        const Entity& local = *players[localPlayer];
+        playerTrack->record({raceTime, local.getPosition(), local.getRotation()}, playerStatus[localPlayer] != Playing);
+    }
+    if (animationsEnabled)
+        updateAnimations(dt);
+    updateCamera();
+}
+
+void Environment::updateAnimations(float dt) {
+    PROFILE_ZONE("Animation");
+    for (const Entity::Ptr& entity : entities)
+        entity->updateAnimation(dt);
+    ghosts.update(dt);
+    background.updateAnimations(dt);
+}
+
+void Environment::updateCamera() {
+    const Entity& target = *players[localPlayer];
+    camera.setCenter(target.getPosition());
+    camera.setRotation(target.getRotation());
+}
+
+void Environment::updateStreaming() {
+    if (!streamer.isOpen())
+        return;
+
+    std::vector<Entity::Ptr> added, removed;
+    streamer.update(players[localPlayer]->getPosition(), added, removed);
 
-    camera.setCenter(player->getPosition());
-    camera.setRotation(player->getRotation());
+    removeEntities(removed);
+    entities.insert(entities.end(), added.begin(), added.end());
 }
 
-void Environment::render(sf::RenderTarget& target) {
+void Environment::render(CountingRenderTarget& target) {
     target.setView(camera);
 
     background.render(target);
@@ -89,13 +254,295 @@ void Environment::render(sf::RenderTarget& target) {
     rect.setOutlineThickness(1);
     target.draw(rect);
 
-    for (Entity::Ptr entity : entities) {
+    ghosts.render(target, raceTime);
+
+    PROFILE_ZONE("Entity render");
+    for (const Entity::Ptr& entity : entities) {
         entity->render(target);
     }
 }
 
+void Environment::updateBroadphase() {
+    // Bounds cover the whole step so that fast movers are paired with what they passed
+    sweptBounds.resize(entities.size());
+    for (unsigned int i = 0; i<entities.size(); ++i) {
+        const Entity& entity = *entities[i];
+        const sf::FloatRect now = entity.getBoundingBox();
+        const sf::Vector2f motion = entity.getPreviousPosition() - entity.getPosition();
+        const float left = std::min(now.left, now.left + motion.x);
+        const float top = std::min(now.top, now.top + motion.y);
+        sweptBounds[i] = sf::FloatRect(left, top, now.width + std::fabs(motion.x), now.height + std::fabs(motion.y));
+    }
+    broadphase.update(sweptBounds);
+}
+
+void Environment::resolveTunneling(float dt) {
+    // Only entities that moved further than their own size in the step can skip through a body.
+    // Each is moved back to its earliest impact with a static body
+    impacts.assign(entities.size(), Impact());
+    for (const SweepAndPrune::Pair& pair : broadphase.getPairs()) {
+        for (unsigned int k = 0; k<2; ++k) {
+            const unsigned int mover = k == 0 ? pair.first : pair.second;
+            const unsigned int body = k == 0 ? pair.second : pair.first;
+            const Entity& a = *entities[mover];
+            const Entity& b = *entities[body];
+            if (!b.isRound() || b.isMovable() || !a.isMovable())
+                continue;
+
+            const sf::Vector2f step = a.getPosition() - a.getPreviousPosition();
+            Circle start = a.getCollisionCircle();
+            if (step.x*step.x + step.y*step.y <= start.radius*start.radius * 4)
+                continue;
+
+            start.center = a.getPreviousPosition();
+            float toi;
+            if (Collision::sweep(start, step, b.getCollisionCircle(), sf::Vector2f(0, 0), toi) &&
+                toi < impacts[mover].toi) {
+                impacts[mover].toi = toi;
+                impacts[mover].body = body;
+            }
+        }
+    }
+
+    for (unsigned int i = 0; i<entities.size(); ++i) {
+        if (impacts[i].toi < 1) {
+            Entity& entity = *entities[i];
+            const sf::Vector2f contact = entity.getPreviousPosition() +
+                (entity.getPosition() - entity.getPreviousPosition()) * impacts[i].toi;
+            sf::Vector2f normal = contact - entities[impacts[i].body]->getPosition();
+            const float length = std::sqrt(normal.x*normal.x + normal.y*normal.y);
+            normal = length > 0 ? normal / length : sf::Vector2f(0, 0);
+            entity.resolveImpact(impacts[i].toi, normal, dt);
+        }
+    }
+}
+
+void Environment::updateStatus() {
+    // Ships pass through each other, so only pairs of a player and something else are checked
+    playerSlots.assign(entities.size(), -1);
+    for (unsigned int i = 0; i<players.size(); ++i) {
+        const auto found = std::find(entities.begin(), entities.end(), players[i]);
+        if (found != entities.end())
+            playerSlots[found - entities.begin()] = i;
+    }
+
+    for (const SweepAndPrune::Pair& pair : broadphase.getPairs()) {
+        if ((playerSlots[pair.first] < 0) == (playerSlots[pair.second] < 0))
+            continue;
+        const unsigned int ship = playerSlots[pair.first] >= 0 ? pair.first : pair.second;
+        const unsigned int other = ship == pair.first ? pair.second : pair.first;
+        PlayerStatus& status = playerStatus[playerSlots[ship]];
+        if (status == Playing && playerCollides(*entities[ship], *entities[other]))
+            status = Dead;
+    }
+
+    for (unsigned int i = 0; i<entities.size(); ++i) {
+        if (playerSlots[i] < 0 || playerStatus[playerSlots[i]] != Playing)
+            continue;
+        const sf::FloatRect box = entities[i]->getBoundingBox();
+        if (victoryRegion.intersects(box))
+            playerStatus[playerSlots[i]] = Won;
+        else if (bounds.width > 0 && bounds.height > 0 && !bounds.intersects(box))
+            playerStatus[playerSlots[i]] = Stranded;
+    }
+}
+
+bool Environment::playerCollides(const Entity& ship, const Entity& entity) const {
+    const bool overlaps = entity.isRound() ?
+        Collision::intersects(entity.getCollisionCircle(), ship.getCollisionBox()) :
+        Collision::intersects(entity.getCollisionBox(), ship.getCollisionBox());
+    if (overlaps)
+        return true;
+
+    // Catch the ship passing through the entity within the step. The swept shapes are the same
+    // as above so that thin boxes can not be skipped over
+    OrientedBox start = ship.getCollisionBox();
+    start.center = ship.getPreviousPosition();
+    const sf::Vector2f shipMotion = ship.getPosition() - ship.getPreviousPosition();
+    const sf::Vector2f entityMotion = entity.getPosition() - entity.getPreviousPosition();
+    float toi;
+    if (entity.isRound()) {
+        Circle other = entity.getCollisionCircle();
+        other.center = entity.getPreviousPosition();
+        return Collision::sweep(other, entityMotion, start, shipMotion, toi);
+    }
+    OrientedBox other = entity.getCollisionBox();
+    other.center = entity.getPreviousPosition();
+    return Collision::sweep(start, shipMotion, other, entityMotion, toi);
+}
+
 Environment::PlayerStatus Environment::getPlayerStatus() const {
-    if (victoryRegion.intersects(player->getBoundingBox()))
-        return PlayerStatus::Won;
-    return PlayerStatus::Playing; //TODO - others
+    return playerStatus[localPlayer];
+}
+
+Environment::PlayerStatus Environment::getPlayerStatus(unsigned int player) const {
+    return playerStatus[player];
+}
+
+float Environment::getRaceTime() const {
+    return raceTime;
+}
+
+const GhostTrack& Environment::getPlayerTrack() const {
+    return *playerTrack;
+}
+
+void Environment::addGhost(GhostTrack::Ptr track) {
+    ghosts.add(track);
+}
+
+void Environment::clearGhosts() {
+    ghosts.clear();
+}
+
+void Environment::setAnimationsEnabled(bool enabled) {
+    animationsEnabled = enabled;
+}
+
+void Environment::setStreaming(Streaming mode) {
+    streamer.setSynchronous(mode != Asynchronous);
+    if (mode == Resident) {
+        const float everywhere = std::numeric_limits<float>::infinity();
+        streamer.setRadius(everywhere, everywhere);
+        updateStreaming();
+    }
+}
+
+void Environment::setPlayerController(EntityController::Ptr controller) {
+    // The player is always created by ControllableEntity::createPlayer
+    static_cast<ControllableEntity&>(*players.front()).setController(controller);
+}
+
+Entity::Ptr Environment::addPlayer(EntityController::Ptr controller) {
+    const sf::Vector2f spawn = players.front()->getPosition() + sf::Vector2f(60.0f * players.size(), 0);
+    Entity::Ptr added = ControllableEntity::create(
+        "Player" + intToString(players.size() + 1), "Ships/ship.anim", spawn, {0, 0}, 10, true, false, -1, controller
+    );
+    players.push_back(added);
+    playerStatus.push_back(Playing);
+    entities.push_back(added);
+    return added;
+}
+
+void Environment::setLocalPlayer(unsigned int player) {
+    if (player >= players.size()) {
+        std::cerr << "No player " << player << ", the environment has " << players.size() << std::endl;
+        return;
+    }
+    localPlayer = player;
+    // The track so far belongs to the previous local player
+    playerTrack->clear();
+    updateCamera();
+}
+
+void Environment::saveState(Snapshot& snapshot) const {
+    snapshot.resize(entities.size());
+    snapshot.playerStatus.assign(playerStatus.begin(), playerStatus.end());
+    snapshot.raceTime = raceTime;
+    snapshot.backgroundSeeds = background.getSeeds();
+
+    std::unordered_map<const Entity*, unsigned int> indices;
+    for (unsigned int i = 0; i<entities.size(); ++i)
+        indices[entities[i].get()] = i;
+
+    for (unsigned int i = 0; i<entities.size(); ++i) {
+        const Entity& entity = *entities[i];
+        const EntityMotion& motion = entity.getMotion();
+        snapshot.nameHash[i] = Snapshot::hashName(entity.getName());
+        snapshot.x[i] = entity.getPosition().x;
+        snapshot.y[i] = entity.getPosition().y;
+        snapshot.vx[i] = entity.getVelocity().x;
+        snapshot.vy[i] = entity.getVelocity().y;
+        snapshot.rotation[i] = entity.getRotation();
+        snapshot.frame[i] = entity.getAnimationFrame();
+        snapshot.motionType[i] = motion.getType();
+
+        if (motion.getType() != EntityMotion::Orbital)
+            continue;
+
+        // An orbit around an entity outside the environment can not be restored, keep it as physics
+        const OrbitalMotion& orbit = static_cast<const OrbitalMotion&>(motion);
+        const auto parent = indices.find(orbit.getParentBody().get());
+        if (parent == indices.end()) {
+            snapshot.motionType[i] = EntityMotion::Physics;
+            continue;
+        }
+        const OrbitalMotion::Parameters params = orbit.getParameters();
+        Snapshot::Orbits& orbits = snapshot.orbits;
+        orbits.entity.push_back(i);
+        orbits.parent.push_back(parent->second);
+        orbits.elapsedTime.push_back(params.elapsedTime);
+        orbits.radius.push_back(params.radius);
+        orbits.orbitalVelocity.push_back(params.orbitalVelocity);
+        orbits.period.push_back(params.period);
+        orbits.insertionAngle.push_back(params.insertionAngle);
+        orbits.clockwise.push_back(params.clockwise ? 1 : 0);
+    }
+}
+
+bool Environment::loadState(const Snapshot& snapshot) {
+    if (snapshot.entityCount() != entities.size()) {
+        std::cerr << "Snapshot has " << snapshot.entityCount() << " entities, environment has "
+                  << entities.size() << std::endl;
+        return false;
+    }
+    for (unsigned int i = 0; i<entities.size(); ++i) {
+        if (snapshot.nameHash[i] != Snapshot::hashName(entities[i]->getName())) {
+            std::cerr << "Snapshot does not match entity " << entities[i]->getName() << std::endl;
+            return false;
+        }
+    }
+    if (snapshot.playerStatus.size() != players.size()) {
+        std::cerr << "Snapshot has " << snapshot.playerStatus.size() << " players, environment has "
+                  << players.size() << std::endl;
+        return false;
+    }
+    for (std::uint32_t status : snapshot.playerStatus) {
+        if (status > Stranded) {
+            std::cerr << "Snapshot has invalid player status " << status << std::endl;
+            return false;
+        }
+    }
+    if (!snapshot.backgroundSeeds.empty() && !background.setSeeds(snapshot.backgroundSeeds)) {
+        std::cerr << "Snapshot does not match the background" << std::endl;
+        return false;
+    }
+
+    for (unsigned int i = 0; i<entities.size(); ++i) {
+        Entity& entity = *entities[i];
+        const sf::Vector2f position(snapshot.x[i], snapshot.y[i]);
+        const sf::Vector2f velocity(snapshot.vx[i], snapshot.vy[i]);
+        if (snapshot.motionType[i] == EntityMotion::Physics) {
+            if (entity.getMotion().getType() == EntityMotion::Physics)
+                entity.getMotion().correct(position, velocity);
+            else
+                entity.changeMotionType(PhysicsMotion::create(position, velocity));
+        }
+        entity.setRotation(snapshot.rotation[i]);
+        entity.setAnimationFrame(snapshot.frame[i]);
+    }
+
+    // Orbits last so that the parents are already in place
+    const Snapshot::Orbits& orbits = snapshot.orbits;
+    for (unsigned int j = 0; j<orbits.entity.size(); ++j) {
+        const unsigned int i = orbits.entity[j];
+        OrbitalMotion::Parameters params;
+        params.elapsedTime = orbits.elapsedTime[j];
+        params.radius = orbits.radius[j];
+        params.orbitalVelocity = orbits.orbitalVelocity[j];
+        params.period = orbits.period[j];
+        params.insertionAngle = orbits.insertionAngle[j];
+        params.clockwise = orbits.clockwise[j] != 0;
+        entities[i]->changeMotionType(OrbitalMotion::create(*entities[orbits.parent[j]], params));
+        entities[i]->getMotion().correct(
+            {snapshot.x[i], snapshot.y[i]}, {snapshot.vx[i], snapshot.vy[i]}
+        );
+    }
+
+    for (unsigned int i = 0; i<players.size(); ++i)
+        playerStatus[i] = static_cast<PlayerStatus>(snapshot.playerStatus[i]);
+    raceTime = snapshot.raceTime;
+    playerTrack->truncate(raceTime);
+    updateCamera();
+    return true;
 }
\ No newline at end of file
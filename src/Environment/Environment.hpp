@@ -1,8 +1,15 @@
 #ifndef ENVIRONMENT_HPP
 #define ENVIRONMENT_HPP
 
+#include <Collision/SweepAndPrune.hpp>
 #include <Entities/Entity.hpp>
+#include <Entities/EntityController.hpp>
 #include <Environment/Background.hpp>
+#include <Environment/ChunkStreamer.hpp>
+#include <Environment/EnvironmentSpec.hpp>
+#include <Environment/Ghosts.hpp>
+#include <Environment/GhostTrack.hpp>
+#include <Environment/Snapshot.hpp>
 
 /**
  * Represents a playable level and all entities within
@@ -15,6 +22,15 @@ public:
         Dead,
         Stranded
     };
+
+    /**
+     * How chunked entities are streamed in
+     */
+    enum Streaming {
+        Asynchronous, // Read in the background as the player approaches. The default
+        Synchronous,  // Read within update() on the tick they are needed, so runs are reproducible
+        Resident      // All loaded up front and kept, so the entity set never changes
+    };
     
     /**
      * Creates the default test environment
@@ -22,10 +38,28 @@ public:
     Environment();
 
     /**
-     * Loads the Environment from the file
+     * Loads the Environment from the file. Compiled environments are detected by extension and
+     * loaded directly, anything else is loaded as json. Chunked entities in compiled environments
+     * are streamed in around the player
      */
     Environment(const std::string& file);
 
+    /**
+     * Creates the Environment from its spec
+     */
+    Environment(const EnvironmentSpec& spec);
+
+    /**
+     * Returns the path of the file the Environment was loaded from. Empty if not loaded from a file
+     */
+    const std::string& getFilename() const;
+
+    /**
+     * Reloads the Environment from its file. Entities and background elements whose definition is
+     * unchanged are kept as they are, along with the player
+     */
+    void reload();
+
     /**
      * Updates the environment and all entities within
      */
@@ -34,16 +68,94 @@ public:
     /**
      * Renders to the target
      */
-    void render(sf::RenderTarget& target);
+    void render(CountingRenderTarget& target);
 
     /**
-     * Returns the PlayerStatus of the environment
+     * Returns the PlayerStatus of the local player. A player is Dead once it touches an Entity
+     * other than another player and Stranded once it leaves the bounds. Anything other than
+     * Playing is final until the Environment is reloaded
      */
     PlayerStatus getPlayerStatus() const;
 
+    /**
+     * Returns the PlayerStatus of the given player, in the order players were added
+     */
+    PlayerStatus getPlayerStatus(unsigned int player) const;
+
+    /**
+     * Returns the seconds of simulation since the Environment was created
+     */
+    float getRaceTime() const;
+
+    /**
+     * Returns the track the local player has taken so far. Ends at the finish once the player has Won
+     */
+    const GhostTrack& getPlayerTrack() const;
+
+    /**
+     * Adds a ghost replaying the track alongside the player. Ghosts are drawn at the race time
+     * and do not affect the simulation
+     */
+    void addGhost(GhostTrack::Ptr track);
+
+    /**
+     * Removes all ghosts
+     */
+    void clearGhosts();
+
+    /**
+     * Sets whether or not animations are advanced by update(). Headless runs turn them off since
+     * nothing is drawn. On by default
+     */
+    void setAnimationsEnabled(bool enabled);
+
+    /**
+     * Sets how chunked entities are streamed. Recorded runs need chunks to arrive on the same tick
+     * every time, and rollback needs the entity set to stay the same as in its snapshots
+     */
+    void setStreaming(Streaming mode);
+
+    /**
+     * Replaces the controller driving the player
+     */
+    void setPlayerController(EntityController::Ptr controller);
+
+    /**
+     * Adds another player beside the first. Players are added after the existing entities, so
+     * every machine in a networked race must add them in the same order. Players pass through
+     * each other and each has a PlayerStatus of its own
+     *
+     * \param controller The controller driving the new player
+     * \return The new player
+     */
+    Entity::Ptr addPlayer(EntityController::Ptr controller);
+
+    /**
+     * Sets the player controlled on this machine. The camera follows it and its status and track
+     * are the ones reported. Defaults to the first player
+     *
+     * \param player Index of the player, in the order players were added
+     */
+    void setLocalPlayer(unsigned int player);
+
+    /**
+     * Captures the simulation state into the snapshot. The snapshot is reused to avoid allocating
+     * every tick
+     */
+    void saveState(Snapshot& snapshot) const;
+
+    /**
+     * Restores state captured by saveState(). The entities must be the same as when the snapshot
+     * was taken, which is checked by count and name
+     *
+     * \return True if the state was restored. Nothing is changed on failure
+     */
+    bool loadState(const Snapshot& snapshot);
+
 private:
     sf::View camera;
 
+    std::string filename;
     std::string name;
     sf::FloatRect victoryRegion;
     sf::FloatRect bounds;
@@ -51,7 +163,41 @@ private:
     Background background;
 
     std::vector<Entity::Ptr> entities;
-    Entity::Ptr player;
+    std::vector<Entity::Ptr> players; // the first is created with the environment
+    std::vector<PlayerStatus> playerStatus; // parallel to players
+    unsigned int localPlayer;
+
+    std::vector<EntitySpec> entitySpecs;
+    std::vector<Entity::Ptr> specEntities; // parallel to entitySpecs
+
+    ChunkStreamer streamer;
+
+    float raceTime;
+    bool animationsEnabled;
+    GhostTrack::Ptr playerTrack;
+    Ghosts ghosts;
+
+    struct Impact {
+        float toi = 1;
+        unsigned int body = 0;
+    };
+
+    SweepAndPrune broadphase;
+    std::vector<sf::FloatRect> sweptBounds; // parallel to entities
+    std::vector<Impact> impacts; // parallel to entities
+    std::vector<int> playerSlots; // index in players for each entity, parallel to entities
+
+    bool readFile(EnvironmentSpec& spec, EnvironmentFormat::ChunkTable& chunks) const;
+    void load(const EnvironmentSpec& spec);
+    void createPlayer(const sf::Vector2f& spawn);
+    void removeEntities(std::vector<Entity::Ptr>& removed);
+    void updateStreaming();
+    void updateBroadphase();
+    void resolveTunneling(float dt);
+    void updateStatus();
+    void updateCamera();
+    void updateAnimations(float dt);
+    bool playerCollides(const Entity& ship, const Entity& entity) const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,467 @@
+#include <Environment/EnvironmentFormat.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+const std::string EnvironmentFormat::Extension = ".senv";
+
+namespace {
+/**
+ * Helper to build the string table while writing
+ */
+class StringTable {
+public:
+    EnvironmentFormat::String add(const std::string& str) {
+        EnvironmentFormat::String ref;
+        ref.offset = data.size();
+        ref.length = str.size();
+        data.insert(data.end(), str.begin(), str.end());
+        return ref;
+    }
+
+    const std::vector<char>& getData() const { return data; }
+
+private:
+    std::vector<char> data;
+};
+
+uint8_t packFlags(const BackgroundElementSpec::Range& range) {
+    typedef EnvironmentFormat::Element Element;
+    return (range.preserveAR ? Element::PreserveAR : 0)
+         | (range.allowHFlip ? Element::AllowHFlip : 0)
+         | (range.allowVFlip ? Element::AllowVFlip : 0);
+}
+
+void packRange(const BackgroundElementSpec::Range& range, float* values) {
+    values[0] = range.minx;
+    values[1] = range.miny;
+    values[2] = range.maxx;
+    values[3] = range.maxy;
+}
+
+BackgroundElementSpec::Range unpackRange(const float* values, uint8_t flags) {
+    typedef EnvironmentFormat::Element Element;
+    BackgroundElementSpec::Range range;
+    range.preserveAR = (flags & Element::PreserveAR) != 0;
+    range.allowHFlip = (flags & Element::AllowHFlip) != 0;
+    range.allowVFlip = (flags & Element::AllowVFlip) != 0;
+    range.minx = values[0];
+    range.miny = values[1];
+    range.maxx = values[2];
+    range.maxy = values[3];
+    return range;
+}
+
+BackgroundElementSpec::Pair unpackPair(const float* values) {
+    BackgroundElementSpec::Pair pair;
+    pair.x = values[0];
+    pair.y = values[1];
+    return pair;
+}
+
+bool getString(const char* strings, uint32_t tableSize, const EnvironmentFormat::String& ref, std::string& out) {
+    if (ref.offset > tableSize || ref.length > tableSize - ref.offset)
+        return false;
+    out.assign(strings + ref.offset, ref.length);
+    return true;
+}
+
+bool unpackEntity(const char* record, const char* strings, uint32_t tableSize, EntitySpec& out) {
+    EnvironmentFormat::Entity entity;
+    std::memcpy(&entity, record, sizeof(entity));
+    out.x = entity.x;
+    out.y = entity.y;
+    out.vx = entity.vx;
+    out.vy = entity.vy;
+    out.mass = entity.mass;
+    out.gravityRange = entity.gravityRange;
+    out.canMove = entity.canMove != 0;
+    out.hasGravity = entity.hasGravity != 0;
+    return getString(strings, tableSize, entity.name, out.name) &&
+           getString(strings, tableSize, entity.gfx, out.gfx);
+}
+
+EnvironmentFormat::Entity packEntity(const EntitySpec& in, StringTable& strings) {
+    EnvironmentFormat::Entity entity;
+    entity.name = strings.add(in.name);
+    entity.gfx = strings.add(in.gfx);
+    entity.x = in.x;
+    entity.y = in.y;
+    entity.vx = in.vx;
+    entity.vy = in.vy;
+    entity.mass = in.mass;
+    entity.gravityRange = in.gravityRange;
+    entity.canMove = in.canMove ? 1 : 0;
+    entity.hasGravity = in.hasGravity ? 1 : 0;
+    std::memset(entity.padding, 0, sizeof(entity.padding));
+    return entity;
+}
+}
+
+bool EnvironmentFormat::isCompiled(const std::string& file) {
+    return file.size() >= Extension.size() &&
+           file.compare(file.size() - Extension.size(), Extension.size(), Extension) == 0;
+}
+
+bool EnvironmentFormat::load(const std::string& file, EnvironmentSpec& spec, ChunkTable* table) {
+    std::ifstream input(file.c_str(), std::ios::in | std::ios::binary);
+    if (!input.good()) {
+        std::cerr << "Failed to open environment: " << file << std::endl;
+        return false;
+    }
+
+    input.seekg(0, std::ios::end);
+    const std::streamoff size = input.tellg();
+    input.seekg(0, std::ios::beg);
+    if (size <= 0) {
+        std::cerr << "Environment file is empty: " << file << std::endl;
+        return false;
+    }
+
+    // Chunk blocks are at the end and are skipped when streaming
+    std::size_t readSize = static_cast<std::size_t>(size);
+    if (table) {
+        char prefix[sizeof(Header) + sizeof(ChunkInfo)];
+        if (readSize >= sizeof(prefix) && input.read(prefix, sizeof(prefix))) {
+            Header header;
+            ChunkInfo info;
+            std::memcpy(&header, prefix, sizeof(Header));
+            std::memcpy(&info, prefix + sizeof(Header), sizeof(ChunkInfo));
+            if (header.version == CurrentVersion) {
+                const std::size_t dataSize = sizeof(Header) + sizeof(ChunkInfo) + info.chunkCount * sizeof(Chunk) +
+                    header.entityCount * sizeof(Entity) + header.elementCount * sizeof(Element) + header.stringTableSize;
+                readSize = std::min(readSize, dataSize);
+            }
+        }
+        input.clear();
+        input.seekg(0, std::ios::beg);
+    }
+
+    std::vector<char> buffer(readSize);
+    input.read(buffer.data(), readSize);
+    if (!input.good()) {
+        std::cerr << "Failed to read environment: " << file << std::endl;
+        return false;
+    }
+
+    if (!parse(buffer.data(), buffer.size(), spec, table)) {
+        std::cerr << "Environment file is corrupt: " << file << std::endl;
+        return false;
+    }
+    if (table) {
+        for (const Chunk& chunk : table->chunks) {
+            if (!chunkInFile(chunk, static_cast<std::uint64_t>(size))) {
+                std::cerr << "Environment file is corrupt: " << file << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool EnvironmentFormat::parse(const char* buffer, std::size_t size, EnvironmentSpec& spec, ChunkTable* table) {
+    spec = EnvironmentSpec();
+    if (table)
+        *table = ChunkTable();
+    if (size < sizeof(Header) || std::memcmp(buffer, Magic, sizeof(Magic)) != 0)
+        return false;
+
+    Header header;
+    std::memcpy(&header, buffer, sizeof(Header));
+    if (header.version != 1 && header.version != CurrentVersion) {
+        std::cerr << "Unsupported environment version: " << header.version << std::endl;
+        return false;
+    }
+
+    ChunkInfo info;
+    info.chunkSize = 0;
+    info.chunkCount = 0;
+    std::size_t chunkOffset = sizeof(Header);
+    if (header.version >= 2) {
+        if (size < sizeof(Header) + sizeof(ChunkInfo))
+            return false;
+        std::memcpy(&info, buffer + sizeof(Header), sizeof(ChunkInfo));
+        chunkOffset += sizeof(ChunkInfo);
+    }
+
+    const std::size_t entityOffset = chunkOffset + info.chunkCount * sizeof(Chunk);
+    const std::size_t elementOffset = entityOffset + header.entityCount * sizeof(Entity);
+    const std::size_t stringOffset = elementOffset + header.elementCount * sizeof(Element);
+    if (stringOffset + header.stringTableSize > size)
+        return false;
+
+    const char* strings = buffer + stringOffset;
+    bool valid = getString(strings, header.stringTableSize, header.name, spec.name);
+    spec.width = header.width;
+    spec.height = header.height;
+    spec.winZone.top = header.winTop;
+    spec.winZone.left = header.winLeft;
+    spec.winZone.width = header.winWidth;
+    spec.winZone.height = header.winHeight;
+    spec.playerSpawn.x = header.spawnX;
+    spec.playerSpawn.y = header.spawnY;
+    spec.background.color.red = header.red;
+    spec.background.color.green = header.green;
+    spec.background.color.blue = header.blue;
+
+    spec.entities.resize(header.entityCount);
+    for (unsigned int i = 0; i < header.entityCount; ++i) {
+        const char* record = buffer + entityOffset + i * sizeof(Entity);
+        if (!unpackEntity(record, strings, header.stringTableSize, spec.entities[i]))
+            valid = false;
+    }
+
+    spec.background.elements.resize(header.elementCount);
+    for (unsigned int i = 0; i < header.elementCount; ++i) {
+        Element element;
+        std::memcpy(&element, buffer + elementOffset + i * sizeof(Element), sizeof(Element));
+        BackgroundElementSpec& out = spec.background.elements[i];
+        if (!getString(strings, header.stringTableSize, element.file, out.file))
+            valid = false;
+
+        switch (element.scaleKind) {
+        case Element::Fixed:
+            out.scale.fixed = unpackPair(element.scale);
+            break;
+        case Element::Ranged:
+            out.scale.ranged = unpackRange(element.scale, element.scaleFlags);
+            break;
+        default:
+            valid = false;
+        }
+
+        switch (element.positioningKind) {
+        case Element::Fixed:
+            out.positioning.fixedSpacing = unpackPair(element.positioning);
+            break;
+        case Element::Ranged:
+            out.positioning.rangedSpacing = unpackRange(element.positioning, element.positioningFlags);
+            break;
+        case Element::Random:
+            out.positioning.random.emplace();
+            out.positioning.random->density = element.positioning[0];
+            break;
+        default:
+            valid = false;
+        }
+    }
+
+    std::vector<Chunk> chunks(info.chunkCount);
+    if (info.chunkCount > 0)
+        std::memcpy(chunks.data(), buffer + chunkOffset, info.chunkCount * sizeof(Chunk));
+
+    if (table) {
+        table->chunkSize = info.chunkSize;
+        table->chunks = std::move(chunks);
+    }
+    else {
+        for (const Chunk& chunk : chunks) {
+            if (!chunkInFile(chunk, size) || !parseChunk(buffer + chunk.offset, chunk, spec.entities))
+                valid = false;
+        }
+    }
+
+    return valid;
+}
+
+std::size_t EnvironmentFormat::chunkBlockSize(const Chunk& chunk) {
+    return chunk.entityCount * sizeof(Entity) + chunk.stringTableSize;
+}
+
+bool EnvironmentFormat::chunkInFile(const Chunk& chunk, std::uint64_t fileSize) {
+    // Compared without adding to the offset so that crafted records cannot wrap around
+    const std::uint64_t blockSize = static_cast<std::uint64_t>(chunk.entityCount) * sizeof(Entity) + chunk.stringTableSize;
+    return chunk.offset <= fileSize && blockSize <= fileSize - chunk.offset;
+}
+
+bool EnvironmentFormat::parseChunk(const char* buffer, const Chunk& chunk, std::vector<EntitySpec>& entities) {
+    const char* strings = buffer + chunk.entityCount * sizeof(Entity);
+    const std::size_t first = entities.size();
+    entities.resize(first + chunk.entityCount);
+    for (unsigned int i = 0; i < chunk.entityCount; ++i) {
+        if (!unpackEntity(buffer + i * sizeof(Entity), strings, chunk.stringTableSize, entities[first + i]))
+            return false;
+    }
+    return true;
+}
+
+bool EnvironmentFormat::loadChunk(std::istream& input, const Chunk& chunk, std::vector<EntitySpec>& entities) {
+    input.clear();
+    input.seekg(0, std::ios::end);
+    const std::streamoff size = input.tellg();
+    if (size < 0 || !chunkInFile(chunk, static_cast<std::uint64_t>(size))) {
+        std::cerr << "Environment chunk " << chunk.x << "," << chunk.y << " is out of the file" << std::endl;
+        return false;
+    }
+
+    std::vector<char> buffer(chunkBlockSize(chunk));
+    input.seekg(static_cast<std::streamoff>(chunk.offset), std::ios::beg);
+    input.read(buffer.data(), buffer.size());
+    if (!input.good()) {
+        std::cerr << "Failed to read environment chunk " << chunk.x << "," << chunk.y << std::endl;
+        return false;
+    }
+    return parseChunk(buffer.data(), chunk, entities);
+}
+
+bool EnvironmentFormat::save(const std::string& file, const EnvironmentSpec& spec, float chunkSize) {
+    StringTable strings;
+
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = CurrentVersion;
+    header.reserved = 0;
+    header.elementCount = spec.background.elements.size();
+    header.name = strings.add(spec.name);
+    header.width = spec.width;
+    header.height = spec.height;
+    header.winTop = spec.winZone.top;
+    header.winLeft = spec.winZone.left;
+    header.winWidth = spec.winZone.width;
+    header.winHeight = spec.winZone.height;
+    header.spawnX = spec.playerSpawn.x;
+    header.spawnY = spec.playerSpawn.y;
+    header.red = spec.background.color.red;
+    header.green = spec.background.color.green;
+    header.blue = spec.background.color.blue;
+
+    // Sort static entities into chunks, keyed by grid coordinate. Chunks are recreated from the file
+    // whenever they load, so movable entities stay in the main table where they are always resident
+    std::vector<Entity> entities;
+    std::map<std::pair<int32_t, int32_t>, std::vector<const EntitySpec*> > chunkMembers;
+    for (const EntitySpec& entity : spec.entities) {
+        if (chunkSize > 0 && !entity.canMove) {
+            const std::pair<int32_t, int32_t> key(
+                static_cast<int32_t>(std::floor(entity.x / chunkSize)),
+                static_cast<int32_t>(std::floor(entity.y / chunkSize))
+            );
+            chunkMembers[key].push_back(&entity);
+        }
+        else
+            entities.push_back(packEntity(entity, strings));
+    }
+    header.entityCount = entities.size();
+
+    std::vector<Element> elements(spec.background.elements.size());
+    for (unsigned int i = 0; i < spec.background.elements.size(); ++i) {
+        const BackgroundElementSpec& in = spec.background.elements[i];
+        Element& element = elements[i];
+        std::memset(&element, 0, sizeof(Element));
+        element.file = strings.add(in.file);
+
+        if (in.scale.fixed) {
+            element.scaleKind = Element::Fixed;
+            element.scale[0] = in.scale.fixed->x;
+            element.scale[1] = in.scale.fixed->y;
+        }
+        else if (in.scale.ranged) {
+            element.scaleKind = Element::Ranged;
+            element.scaleFlags = packFlags(*in.scale.ranged);
+            packRange(*in.scale.ranged, element.scale);
+        }
+        else {
+            std::cerr << "Background element " << in.file << " has no scale" << std::endl;
+            return false;
+        }
+
+        if (in.positioning.fixedSpacing) {
+            element.positioningKind = Element::Fixed;
+            element.positioning[0] = in.positioning.fixedSpacing->x;
+            element.positioning[1] = in.positioning.fixedSpacing->y;
+        }
+        else if (in.positioning.rangedSpacing) {
+            element.positioningKind = Element::Ranged;
+            element.positioningFlags = packFlags(*in.positioning.rangedSpacing);
+            packRange(*in.positioning.rangedSpacing, element.positioning);
+        }
+        else if (in.positioning.random) {
+            element.positioningKind = Element::Random;
+            element.positioning[0] = in.positioning.random->density;
+        }
+        else {
+            std::cerr << "Background element " << in.file << " has no positioning" << std::endl;
+            return false;
+        }
+    }
+
+    header.stringTableSize = strings.getData().size();
+
+    ChunkInfo info;
+    info.chunkSize = chunkSize > 0 ? chunkSize : 0;
+    info.chunkCount = chunkMembers.size();
+
+    std::vector<char> buffer(
+        sizeof(Header) + sizeof(ChunkInfo) + chunkMembers.size() * sizeof(Chunk) + entities.size() * sizeof(Entity) +
+        elements.size() * sizeof(Element) + strings.getData().size()
+    );
+
+    // Chunk blocks are appended after the main data, filling in the chunk table as they go
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunkMembers.size());
+    for (const auto& members : chunkMembers) {
+        Chunk chunk;
+        chunk.x = members.first.first;
+        chunk.y = members.first.second;
+        chunk.entityCount = members.second.size();
+        chunk.offset = buffer.size();
+
+        // Aggregate gravity of the chunk for use while it is unloaded
+        double mass = 0, cx = 0, cy = 0;
+        for (const EntitySpec* entity : members.second) {
+            if (entity->hasGravity) {
+                mass += entity->mass;
+                cx += entity->x * entity->mass;
+                cy += entity->y * entity->mass;
+            }
+        }
+        chunk.mass = mass;
+        chunk.centerX = mass > 0 ? cx / mass : (chunk.x + 0.5f) * chunkSize;
+        chunk.centerY = mass > 0 ? cy / mass : (chunk.y + 0.5f) * chunkSize;
+        chunk.radius = 0;
+        for (const EntitySpec* entity : members.second) {
+            if (entity->hasGravity)
+                chunk.radius = std::max(chunk.radius, std::hypot(entity->x - chunk.centerX, entity->y - chunk.centerY));
+        }
+
+        StringTable chunkStrings;
+        std::vector<Entity> chunkEntities;
+        chunkEntities.reserve(members.second.size());
+        for (const EntitySpec* entity : members.second)
+            chunkEntities.push_back(packEntity(*entity, chunkStrings));
+        chunk.stringTableSize = chunkStrings.getData().size();
+
+        const char* entityData = reinterpret_cast<const char*>(chunkEntities.data());
+        buffer.insert(buffer.end(), entityData, entityData + chunkEntities.size() * sizeof(Entity));
+        buffer.insert(buffer.end(), chunkStrings.getData().begin(), chunkStrings.getData().end());
+        chunks.push_back(chunk);
+    }
+
+    char* out = buffer.data();
+    std::memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header);
+    std::memcpy(out, &info, sizeof(ChunkInfo));
+    out += sizeof(ChunkInfo);
+    if (!chunks.empty())
+        std::memcpy(out, chunks.data(), chunks.size() * sizeof(Chunk));
+    out += chunks.size() * sizeof(Chunk);
+    if (!entities.empty())
+        std::memcpy(out, entities.data(), entities.size() * sizeof(Entity));
+    out += entities.size() * sizeof(Entity);
+    if (!elements.empty())
+        std::memcpy(out, elements.data(), elements.size() * sizeof(Element));
+    out += elements.size() * sizeof(Element);
+    if (!strings.getData().empty())
+        std::memcpy(out, strings.getData().data(), strings.getData().size());
+
+    std::ofstream output(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    output.write(buffer.data(), buffer.size());
+    if (!output.good()) {
+        std::cerr << "Failed to write environment: " << file << std::endl;
+        return false;
+    }
+    return true;
+}
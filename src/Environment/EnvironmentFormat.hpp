@@ -0,0 +1,190 @@
+#ifndef ENVIRONMENTFORMAT_HPP
+#define ENVIRONMENTFORMAT_HPP
+
+#include <Environment/EnvironmentSpec.hpp>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/**
+ * Describes the on-disk layout of compiled environment files and handles reading and writing them.
+ * Compiled environments are produced offline from the json files by the EnvironmentCompiler tool
+ * and are loaded with a single read and no parsing or validation. Data is little endian
+ *
+ * Two versions are supported:
+ *
+ *  - v1: Header | Entity[entityCount] | Element[elementCount] | string table
+ *  - v2: Header | ChunkInfo | Chunk[chunkCount] | Entity[entityCount] | Element[elementCount] |
+ *        string table | chunk blocks
+ *
+ * Strings are stored in the table and referenced by offset and length. In v2 files static entities
+ * may be split into square spatial chunks, while movable entities always stay in the main table. Each chunk block is Entity[entityCount] | string table and is
+ * loaded on its own, so chunked entities are not read when the environment is opened. The chunk
+ * table holds the total mass and center of mass of each chunk for approximating its gravity while
+ * it is not loaded
+ */
+struct EnvironmentFormat {
+    static constexpr char Magic[4] = {'S', 'R', 'E', 'N'};
+    static constexpr uint16_t CurrentVersion = 2;
+    static const std::string Extension;
+
+#pragma pack(push, 1)
+    /**
+     * Reference to a string in the string table
+     */
+    struct String {
+        uint32_t offset;
+        uint32_t length;
+    };
+
+    /**
+     * Leading block of the file. Contains all of the non-list environment data
+     */
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t entityCount;
+        uint32_t elementCount;
+        uint32_t stringTableSize;
+        String name;
+        float width, height;
+        float winTop, winLeft, winWidth, winHeight;
+        float spawnX, spawnY;
+        float red, green, blue;
+    };
+
+    /**
+     * Packed EntitySpec
+     */
+    struct Entity {
+        String name;
+        String gfx;
+        float x, y;
+        float vx, vy;
+        float mass;
+        float gravityRange;
+        uint8_t canMove;
+        uint8_t hasGravity;
+        uint8_t padding[2];
+    };
+
+    /**
+     * Packed BackgroundElementSpec. The kinds select which union option the values are for. Ranges
+     * use all four values, pairs use the first two and random positioning uses the first
+     */
+    struct Element {
+        enum Kind : uint8_t {
+            Fixed = 0,
+            Ranged = 1,
+            Random = 2
+        };
+
+        enum Flags : uint8_t {
+            PreserveAR = 1 << 0,
+            AllowHFlip = 1 << 1,
+            AllowVFlip = 1 << 2
+        };
+
+        String file;
+        uint8_t scaleKind, scaleFlags;
+        uint8_t positioningKind, positioningFlags;
+        float scale[4];
+        float positioning[4];
+    };
+
+    /**
+     * Follows the header in v2 files
+     */
+    struct ChunkInfo {
+        float chunkSize;
+        uint32_t chunkCount;
+    };
+
+    /**
+     * Entry in the chunk table. Chunk x and y are the grid coordinates of the chunk. The offset is
+     * the absolute position of the chunk block in the file
+     */
+    struct Chunk {
+        int32_t x, y;
+        uint32_t entityCount;
+        uint32_t stringTableSize;
+        uint64_t offset;
+        float mass;
+        float centerX, centerY;
+        float radius;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(Header) == 72, "Environment header must be packed");
+    static_assert(sizeof(Entity) == 44, "Environment entity must be packed");
+    static_assert(sizeof(Element) == 44, "Environment element must be packed");
+    static_assert(sizeof(ChunkInfo) == 8, "Environment chunk info must be packed");
+    static_assert(sizeof(Chunk) == 40, "Environment chunk must be packed");
+
+    /**
+     * Chunk table of a loaded file. Empty if the file is not chunked
+     */
+    struct ChunkTable {
+        float chunkSize;
+        std::vector<Chunk> chunks;
+
+        ChunkTable() : chunkSize(0) {}
+    };
+
+    /**
+     * Returns true if the filename has the compiled environment extension
+     */
+    static bool isCompiled(const std::string& file);
+
+    /**
+     * Loads the given compiled file
+     *
+     * \param file The path of the file to load
+     * \param spec The object to populate
+     * \param table If given, receives the chunk table and chunked entities are left unloaded.
+     *              Otherwise all chunks are loaded into the spec
+     * \return True on success, false on error
+     */
+    static bool load(const std::string& file, EnvironmentSpec& spec, ChunkTable* table = nullptr);
+
+    /**
+     * Parses a compiled environment from a buffer already in memory
+     *
+     * \param buffer Pointer to the file contents
+     * \param size Size of the buffer in bytes
+     * \param spec The object to populate
+     * \param table If given, receives the chunk table and chunked entities are left unloaded.
+     *              Otherwise the buffer must contain the whole file and all chunks are loaded
+     * \return True on success, false on error
+     */
+    static bool parse(const char* buffer, std::size_t size, EnvironmentSpec& spec, ChunkTable* table = nullptr);
+
+    /**
+     * Loads the entities of a single chunk. Safe to call from any thread
+     *
+     * \param input The compiled file
+     * \param chunk The chunk to load
+     * \param entities Vector to append the loaded entities to
+     * \return True on success, false on error
+     */
+    static bool loadChunk(std::istream& input, const Chunk& chunk, std::vector<EntitySpec>& entities);
+
+    /**
+     * Writes the environment to the given file
+     *
+     * \param file The path of the file to write
+     * \param spec The environment to save
+     * \param chunkSize If positive, static entities are split into square chunks of this size
+     * \return True on success, false on error
+     */
+    static bool save(const std::string& file, const EnvironmentSpec& spec, float chunkSize = 0);
+
+private:
+    static std::size_t chunkBlockSize(const Chunk& chunk);
+    static bool chunkInFile(const Chunk& chunk, std::uint64_t fileSize);
+    static bool parseChunk(const char* buffer, const Chunk& chunk, std::vector<EntitySpec>& entities);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef ENVIRONMENTSPEC_HPP
+#define ENVIRONMENTSPEC_HPP
+
+#include <Entities/EntitySpec.hpp>
+#include <Environment/BackgroundSpec.hpp>
+
+/**
+ * Plain description of an Environment as stored in environment files
+ */
+struct EnvironmentSpec {
+    struct Region {
+        float top = 0, left = 0;
+        float width = 0, height = 0;
+    };
+
+    struct Point {
+        float x = 0, y = 0;
+    };
+
+    std::string name;
+    float width = 0, height = 0;
+    BackgroundSpec background;
+    Region winZone;
+    Point playerSpawn;
+    std::vector<EntitySpec> entities;
+};
+
+#endif
\ No newline at end of file
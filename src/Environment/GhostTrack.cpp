@@ -0,0 +1,180 @@
+#include <Environment/GhostTrack.hpp>
+#include <Util/ByteStream.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+constexpr char Magic[4] = {'S', 'R', 'G', 'T'};
+constexpr std::uint32_t Version = 1;
+constexpr std::size_t MaxSamples = 1 << 24; // guards the allocation against corrupt files
+constexpr unsigned int Channels = 4;
+constexpr float Scales[Channels] = {10000, 16, 16, 16}; // 0.1 ms, 1/16 pixel, 1/16 degree
+
+// Differences are taken modulo 2^32 so that the round trip is exact for any input
+std::uint32_t zigzag(std::uint32_t v) {
+    return (v << 1) ^ (0u - (v >> 31));
+}
+
+std::uint32_t unzigzag(std::uint32_t v) {
+    return (v >> 1) ^ (0u - (v & 1));
+}
+
+void toChannels(const GhostTrack::Sample& sample, float* values) {
+    values[0] = sample.time;
+    values[1] = sample.position.x;
+    values[2] = sample.position.y;
+    values[3] = sample.rotation;
+}
+}
+
+GhostTrack::GhostTrack(float sampleInterval)
+: sampleInterval(sampleInterval) {}
+
+GhostTrack::Ptr GhostTrack::create(float sampleInterval) {
+    return Ptr(new GhostTrack(sampleInterval));
+}
+
+void GhostTrack::record(const Sample& sample, bool force) {
+    if (!samples.empty()) {
+        const float last = samples.back().time;
+        if (sample.time < last || (!force && sample.time < last + sampleInterval))
+            return;
+        if (sample.time == last)
+            samples.pop_back();
+    }
+    samples.push_back(sample);
+}
+
+void GhostTrack::truncate(float time) {
+    const auto end = std::upper_bound(samples.begin(), samples.end(), time, [](float t, const Sample& s) {
+        return t < s.time;
+    });
+    samples.erase(end, samples.end());
+}
+
+void GhostTrack::clear() {
+    samples.clear();
+}
+
+GhostTrack::Sample GhostTrack::sample(float time, unsigned int& cursor) const {
+    if (samples.empty())
+        return Sample();
+
+    // Seek from the start again if played back past the cursor, such as after a rewind
+    if (cursor >= samples.size() || samples[cursor].time > time) {
+        const auto after = std::upper_bound(samples.begin(), samples.end(), time, [](float t, const Sample& s) {
+            return t < s.time;
+        });
+        cursor = after == samples.begin() ? 0 : after - samples.begin() - 1;
+    }
+    while (cursor + 1 < samples.size() && samples[cursor + 1].time <= time)
+        ++cursor;
+
+    const Sample& a = samples[cursor];
+    if (cursor + 1 >= samples.size() || time <= a.time)
+        return a;
+    const Sample& b = samples[cursor + 1];
+    const float t = (time - a.time) / (b.time - a.time);
+
+    Sample result;
+    result.time = time;
+    result.position = a.position + (b.position - a.position) * t;
+    result.rotation = a.rotation + (b.rotation - a.rotation) * t;
+    return result;
+}
+
+float GhostTrack::getDuration() const {
+    return samples.empty() ? 0 : samples.back().time;
+}
+
+unsigned int GhostTrack::size() const {
+    return samples.size();
+}
+
+bool GhostTrack::save(const std::string& file) const {
+    std::vector<std::uint8_t> data;
+    data.reserve(16 + samples.size() * Channels * 2);
+    ByteWriter writer(data);
+    writer.bytes(Magic, 4);
+    writer.u32(Version);
+    std::uint32_t intervalBits;
+    std::memcpy(&intervalBits, &sampleInterval, 4);
+    writer.u32(intervalBits);
+    writer.u32(samples.size());
+
+    std::uint32_t previous[Channels] = {};
+    std::uint32_t delta[Channels] = {};
+    for (const Sample& sample : samples) {
+        float values[Channels];
+        toChannels(sample, values);
+        for (unsigned int c = 0; c < Channels; ++c) {
+            const std::uint32_t q = static_cast<std::int32_t>(std::lround(values[c] * Scales[c]));
+            const std::uint32_t d = q - previous[c];
+            writer.varint(zigzag(d - delta[c]));
+            previous[c] = q;
+            delta[c] = d;
+        }
+    }
+
+    std::ofstream output(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    output.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!output.good()) {
+        std::cerr << "Failed to write ghost track: " << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+GhostTrack::Ptr GhostTrack::load(const std::string& file) {
+    std::ifstream input(file.c_str(), std::ios::in | std::ios::binary);
+    if (!input.good())
+        return nullptr;
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (data.size() < 4 || std::memcmp(data.data(), Magic, 4) != 0) {
+        std::cerr << "Not a ghost track: " << file << std::endl;
+        return nullptr;
+    }
+
+    ByteReader reader(data.data() + 4, data.size() - 4);
+    const std::uint32_t version = reader.u32();
+    if (version != Version) {
+        std::cerr << "Unsupported ghost track version " << version << ": " << file << std::endl;
+        return nullptr;
+    }
+    const std::uint32_t intervalBits = reader.u32();
+    float sampleInterval;
+    std::memcpy(&sampleInterval, &intervalBits, 4);
+    const std::uint32_t count = reader.u32();
+    // Every sample takes at least a byte per channel
+    if (reader.hasFailed() || count > MaxSamples || count * Channels > reader.remaining()) {
+        std::cerr << "Ghost track is corrupt: " << file << std::endl;
+        return nullptr;
+    }
+
+    Ptr track(new GhostTrack(sampleInterval));
+    track->samples.resize(count);
+    std::uint32_t previous[Channels] = {};
+    std::uint32_t delta[Channels] = {};
+    for (Sample& sample : track->samples) {
+        float values[Channels];
+        for (unsigned int c = 0; c < Channels; ++c) {
+            delta[c] += unzigzag(reader.varint());
+            previous[c] += delta[c];
+            values[c] = static_cast<std::int32_t>(previous[c]) / Scales[c];
+        }
+        sample.time = values[0];
+        sample.position = {values[1], values[2]};
+        sample.rotation = values[3];
+    }
+    if (reader.hasFailed()) {
+        std::cerr << "Ghost track is corrupt: " << file << std::endl;
+        return nullptr;
+    }
+    return track;
+}
\ No newline at end of file
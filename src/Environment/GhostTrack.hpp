@@ -0,0 +1,89 @@
+#ifndef GHOSTTRACK_HPP
+#define GHOSTTRACK_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <SFML/System.hpp>
+
+/**
+ * Trajectory of a ship over a race: position and rotation sampled against race time. Used to
+ * replay earlier runs as ghosts. Samples are taken at a fixed interval and interpolated between
+ *
+ * Saved tracks are quantized to fixed point and stored as the difference between consecutive
+ * deltas, zigzag varint encoded. Ships move smoothly, so most values fit in a byte or two
+ */
+class GhostTrack {
+public:
+    typedef std::shared_ptr<GhostTrack> Ptr;
+
+    struct Sample {
+        float time = 0;
+        sf::Vector2f position;
+        float rotation = 0;
+    };
+
+    static constexpr float DefaultSampleInterval = 1.0f / 30;
+
+    /**
+     * Creates an empty track
+     *
+     * \param sampleInterval Seconds of race time between samples
+     */
+    static Ptr create(float sampleInterval = DefaultSampleInterval);
+
+    /**
+     * Loads a track written by save(). Returns null if the file is missing or corrupt
+     */
+    static Ptr load(const std::string& file);
+
+    /**
+     * Writes the track to the file
+     */
+    bool save(const std::string& file) const;
+
+    /**
+     * Adds a sample if the interval has passed since the last one. Samples must not go back in time
+     *
+     * \param sample The sample to add
+     * \param force True to add the sample regardless of the interval, such as at the finish
+     */
+    void record(const Sample& sample, bool force = false);
+
+    /**
+     * Discards samples after the given time. Used when the race is rewound
+     */
+    void truncate(float time);
+
+    /**
+     * Removes all samples
+     */
+    void clear();
+
+    /**
+     * Returns the interpolated sample at the given time, clamped to the ends of the track
+     *
+     * \param time The race time to sample at
+     * \param cursor Index of the sample found last time. Playback moves forward, so keeping this
+     *               per viewer makes sampling constant time. Start from 0
+     */
+    Sample sample(float time, unsigned int& cursor) const;
+
+    /**
+     * Returns the time of the last sample
+     */
+    float getDuration() const;
+
+    /**
+     * Returns the number of samples
+     */
+    unsigned int size() const;
+
+private:
+    float sampleInterval;
+    std::vector<Sample> samples;
+
+    GhostTrack(float sampleInterval);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <Environment/Ghosts.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <Properties.hpp>
+#include <Util/FastTrig.hpp>
+#include <Util/Profiler.hpp>
+#include <Util/ResourcePool.hpp>
+
+namespace {
+const float GhostAlpha = 0.45f;
+}
+
+Ghosts::Ghosts()
+: texture(nullptr)
+, radius(0)
+, vertices(sf::Quads) {}
+
+void Ghosts::add(GhostTrack::Ptr track) {
+    // The animation is only loaded once there is something to show
+    if (!animSrc) {
+        animSrc = animPool.loadResource(Properties::EntityAnimationPath+"Ships/ship.anim");
+        if (animSrc)
+            animation.setSource(animSrc, true);
+    }
+    ghosts.push_back({track, 0});
+}
+
+void Ghosts::clear() {
+    ghosts.clear();
+}
+
+unsigned int Ghosts::size() const {
+    return ghosts.size();
+}
+
+void Ghosts::update(float dt) {
+    if (animSrc)
+        animation.update(dt);
+}
+
+void Ghosts::buildFrame(unsigned int frame) {
+    frameQuads.clear();
+    texture = nullptr;
+    radius = 0;
+
+    for (const sf::Sprite& piece : animSrc->getFrame(frame, {0, 0}, {1, 1}, 0, true)) {
+        // All pieces come from the same sheet
+        texture = piece.getTexture();
+        const sf::IntRect rect = piece.getTextureRect();
+        const sf::Transform& transform = piece.getTransform();
+        sf::Color color = piece.getColor();
+        color.a = static_cast<sf::Uint8>(color.a * GhostAlpha);
+
+        const sf::Vector2f corners[4] = {
+            {0, 0}, {float(rect.width), 0}, {float(rect.width), float(rect.height)}, {0, float(rect.height)}
+        };
+        for (const sf::Vector2f& corner : corners) {
+            sf::Vertex vertex;
+            vertex.position = transform.transformPoint(corner);
+            vertex.texCoords = {rect.left + corner.x, rect.top + corner.y};
+            vertex.color = color;
+            frameQuads.push_back(vertex);
+            radius = std::max(radius, std::sqrt(vertex.position.x*vertex.position.x + vertex.position.y*vertex.position.y));
+        }
+    }
+}
+
+void Ghosts::render(CountingRenderTarget& target, float time) {
+    if (ghosts.empty() || !animSrc)
+        return;
+
+    PROFILE_ZONE("Ghost render");
+    buildFrame(animation.getCurrentFrame());
+    if (frameQuads.empty() || !texture)
+        return;
+
+    // The view may be rotated, so cull against the circle around it
+    const sf::View& view = target.getView();
+    const sf::Vector2f half = view.getSize() / 2.0f;
+    const float reach = std::sqrt(half.x*half.x + half.y*half.y) + radius;
+
+    vertices.clear();
+    for (Ghost& ghost : ghosts) {
+        const GhostTrack::Sample sample = ghost.track->sample(time, ghost.cursor);
+        const sf::Vector2f offset = sample.position - view.getCenter();
+        if (offset.x*offset.x + offset.y*offset.y > reach*reach)
+            continue;
+
+        float s, c;
+        FastTrig::sinCos(sample.rotation, s, c);
+        for (sf::Vertex vertex : frameQuads) {
+            const sf::Vector2f p = vertex.position;
+            vertex.position = sample.position + sf::Vector2f(p.x*c - p.y*s, p.x*s + p.y*c);
+            vertices.append(vertex);
+        }
+    }
+
+    if (vertices.getVertexCount() > 0)
+        target.draw(vertices, sf::RenderStates(texture));
+}
\ No newline at end of file
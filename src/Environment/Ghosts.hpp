@@ -0,0 +1,70 @@
+#ifndef GHOSTS_HPP
+#define GHOSTS_HPP
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include <Environment/GhostTrack.hpp>
+#include <Media/Animation.hpp>
+#include <Media/CountingRenderTarget.hpp>
+
+/**
+ * Ships replaying recorded tracks. Ghosts are not entities: they take no part in gravity or
+ * collision and only cost a track lookup and a quad per frame
+ *
+ * All ghosts share the ship animation and are drawn together in a single vertex array, so the
+ * draw cost stays flat with hundreds of ghosts
+ */
+class Ghosts {
+public:
+    Ghosts();
+
+    /**
+     * Adds a ghost replaying the given track
+     */
+    void add(GhostTrack::Ptr track);
+
+    /**
+     * Removes all ghosts
+     */
+    void clear();
+
+    /**
+     * Returns the number of ghosts
+     */
+    unsigned int size() const;
+
+    /**
+     * Advances the shared ship animation
+     */
+    void update(float dt);
+
+    /**
+     * Renders every ghost where its track is at the given time. Ghosts outside the view are skipped
+     *
+     * \param target The target to render to
+     * \param time The race time
+     */
+    void render(CountingRenderTarget& target, float time);
+
+private:
+    struct Ghost {
+        GhostTrack::Ptr track;
+        unsigned int cursor;
+    };
+
+    std::vector<Ghost> ghosts;
+    AnimationReference animSrc;
+    Animation animation;
+
+    // Quads of the current animation frame around the origin, and the texture they are from.
+    // Rebuilt every frame so that reloaded animations show up
+    std::vector<sf::Vertex> frameQuads;
+    const sf::Texture* texture;
+    float radius;
+
+    sf::VertexArray vertices;
+
+    void buildFrame(unsigned int frame);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include <Environment/RewindBuffer.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <Environment/Environment.hpp>
+
+RewindBuffer::RewindBuffer(std::size_t memoryBudget, unsigned int sampleInterval, unsigned int keyframeInterval)
+: memoryBudget(memoryBudget)
+, sampleInterval(std::max(sampleInterval, 1u))
+, keyframeInterval(std::max(keyframeInterval, 1u))
+, memoryUsage(0)
+, tick(0)
+, sinceKeyframe(0)
+, hasPrevious(false) {}
+
+std::size_t RewindBuffer::sampleSize(const Sample& sample) {
+    return sizeof(Sample) + sample.data.size();
+}
+
+void RewindBuffer::record(const Environment& environment) {
+    const std::uint64_t now = tick++;
+    if (now % sampleInterval != 0)
+        return;
+
+    environment.saveState(current);
+    Sample sample;
+    sample.tick = now;
+    const bool wantKeyframe = !hasPrevious || samples.empty() || sinceKeyframe >= keyframeInterval;
+    sample.keyframe = !current.encode(sample.data, wantKeyframe ? nullptr : &previous);
+    sample.data.shrink_to_fit();
+    sinceKeyframe = sample.keyframe ? 1 : sinceKeyframe + 1;
+
+    memoryUsage += sampleSize(sample);
+    samples.push_back(std::move(sample));
+    std::swap(current, previous);
+    hasPrevious = true;
+    evict();
+}
+
+void RewindBuffer::evict() {
+    // Deltas can not be decoded without their keyframe, so whole groups are dropped
+    while (memoryUsage > memoryBudget) {
+        std::size_t groupEnd = 1;
+        while (groupEnd < samples.size() && !samples[groupEnd].keyframe)
+            ++groupEnd;
+        if (groupEnd >= samples.size())
+            break;
+        for (std::size_t i = 0; i < groupEnd; ++i) {
+            memoryUsage -= sampleSize(samples.front());
+            samples.pop_front();
+        }
+    }
+}
+
+void RewindBuffer::dropBack() {
+    memoryUsage -= sampleSize(samples.back());
+    samples.pop_back();
+}
+
+bool RewindBuffer::stepBack(Environment& environment, unsigned int count) {
+    if (samples.empty() || count == 0)
+        return false;
+    sf::Clock clock;
+
+    // The newest sample only counts as a step if the environment has moved on from it
+    const unsigned int newest = samples.size() - 1;
+    const unsigned int steps = samples.back().tick + 1 == tick ? count : count - 1;
+    const unsigned int target = newest - std::min(steps, newest);
+
+    unsigned int keyframe = target;
+    while (keyframe > 0 && !samples[keyframe].keyframe)
+        --keyframe;
+
+    // Decode forward from the keyframe, each delta against the state before it
+    for (unsigned int i = keyframe; i <= target; ++i) {
+        const Sample& sample = samples[i];
+        if (!current.decode(sample.data.data(), sample.data.size(), &previous)) {
+            std::cerr << "Failed to decode rewind sample at tick " << sample.tick << std::endl;
+            hasPrevious = false;
+            return false;
+        }
+        std::swap(current, previous);
+    }
+    if (!environment.loadState(previous)) {
+        hasPrevious = false;
+        return false;
+    }
+
+    while (samples.size() > target + 1)
+        dropBack();
+    tick = samples.back().tick + 1;
+    sinceKeyframe = target - keyframe + 1;
+    lastRestoreTime = clock.getElapsedTime();
+    return true;
+}
+
+void RewindBuffer::clear() {
+    samples.clear();
+    memoryUsage = 0;
+    tick = 0;
+    sinceKeyframe = 0;
+    hasPrevious = false;
+}
+
+std::size_t RewindBuffer::getMemoryUsage() const {
+    return memoryUsage;
+}
+
+unsigned int RewindBuffer::getSampleCount() const {
+    return samples.size();
+}
+
+unsigned int RewindBuffer::getTickSpan() const {
+    return samples.empty() ? 0 : tick - samples.front().tick;
+}
+
+sf::Time RewindBuffer::getLastRestoreTime() const {
+    return lastRestoreTime;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef REWINDBUFFER_HPP
+#define REWINDBUFFER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <SFML/System.hpp>
+#include <Environment/Snapshot.hpp>
+
+class Environment;
+
+/**
+ * Bounded history of Environment states for rewinding. A state is sampled every few ticks and
+ * stored encoded, with a full keyframe every so many samples and deltas against the previous
+ * sample in between. Restoring decodes forward from the nearest keyframe, so the restore cost is
+ * bounded by the keyframe interval
+ *
+ * The oldest keyframe and its deltas are dropped together once the memory budget is exceeded
+ */
+class RewindBuffer {
+public:
+    /**
+     * Creates an empty buffer
+     *
+     * \param memoryBudget Maximum bytes of encoded state to keep. The newest keyframe is always kept
+     * \param sampleInterval Number of ticks between samples
+     * \param keyframeInterval Number of samples between keyframes
+     */
+    RewindBuffer(std::size_t memoryBudget, unsigned int sampleInterval, unsigned int keyframeInterval);
+
+    /**
+     * Call once per tick. Samples the environment if the tick is due
+     */
+    void record(const Environment& environment);
+
+    /**
+     * Restores an earlier sample and discards everything after it, so that recording continues
+     * from the restored state
+     *
+     * \param environment The environment to restore. Must be the one that was recorded
+     * \param samples How many samples to go back. Stops at the oldest sample
+     * \return True if a state was restored
+     */
+    bool stepBack(Environment& environment, unsigned int samples = 1);
+
+    /**
+     * Drops all samples. Call when the environment is replaced or reloaded
+     */
+    void clear();
+
+    /**
+     * Returns the number of bytes used by the stored samples
+     */
+    std::size_t getMemoryUsage() const;
+
+    /**
+     * Returns the number of stored samples
+     */
+    unsigned int getSampleCount() const;
+
+    /**
+     * Returns how far back the buffer reaches, in ticks
+     */
+    unsigned int getTickSpan() const;
+
+    /**
+     * Returns the time taken by the last call to stepBack()
+     */
+    sf::Time getLastRestoreTime() const;
+
+private:
+    struct Sample {
+        std::uint64_t tick;
+        bool keyframe;
+        std::vector<std::uint8_t> data;
+    };
+
+    const std::size_t memoryBudget;
+    const unsigned int sampleInterval;
+    const unsigned int keyframeInterval;
+
+    std::deque<Sample> samples;
+    std::size_t memoryUsage;
+    std::uint64_t tick;
+    unsigned int sinceKeyframe;
+    sf::Time lastRestoreTime;
+
+    // The last recorded state is the base for the next delta
+    Snapshot current, previous;
+    bool hasPrevious;
+
+    void evict();
+    void dropBack();
+    static std::size_t sampleSize(const Sample& sample);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include <Environment/Snapshot.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <Util/ByteStream.hpp>
+
+namespace {
+constexpr char Magic[4] = {'S', 'R', 'S', 'N'};
+constexpr std::uint16_t Version = 3;
+constexpr std::uint16_t DeltaFlag = 1;
+constexpr unsigned int HeaderSize = 12;
+constexpr unsigned int CountWords = 5;
+constexpr std::size_t MaxWords = 1 << 24; // guards the allocation against corrupt headers
+
+template<typename T>
+void readColumn(const std::vector<std::uint32_t>& words, std::size_t& offset, std::vector<T>& column, unsigned int n) {
+    column.resize(n);
+    if (n > 0)
+        std::memcpy(column.data(), &words[offset], n * 4);
+    offset += n;
+}
+}
+
+void Snapshot::resize(unsigned int n) {
+    nameHash.resize(n);
+    x.resize(n);
+    y.resize(n);
+    vx.resize(n);
+    vy.resize(n);
+    rotation.resize(n);
+    frame.resize(n);
+    motionType.resize(n);
+    orbits = Orbits();
+}
+
+unsigned int Snapshot::entityCount() const {
+    return nameHash.size();
+}
+
+std::uint32_t Snapshot::hashName(const std::string& name) {
+    // FNV-1a, stable across platforms so saved snapshots stay valid
+    std::uint32_t hash = 2166136261u;
+    for (char c : name) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+std::size_t Snapshot::packedSize() const {
+    return CountWords + entityCount() * 8 + orbits.entity.size() * 8 + backgroundSeeds.size() * 2 +
+        playerStatus.size();
+}
+
+template<typename F>
+void Snapshot::forEachRun(F visitor) const {
+    std::uint32_t counts[CountWords] = {
+        entityCount(),
+        static_cast<std::uint32_t>(orbits.entity.size()),
+        static_cast<std::uint32_t>(backgroundSeeds.size()),
+        static_cast<std::uint32_t>(playerStatus.size()),
+        0
+    };
+    std::memcpy(&counts[4], &raceTime, 4);
+    visitor(counts, CountWords);
+
+    // Columns are all 32 bit, so their storage is already packed
+    auto column = [&visitor](const auto& values) {
+        static_assert(sizeof(values[0]) == 4, "Columns must be 32 bit");
+        if (!values.empty())
+            visitor(values.data(), values.size());
+    };
+    column(nameHash);
+    column(x);
+    column(y);
+    column(vx);
+    column(vy);
+    column(rotation);
+    column(frame);
+    column(motionType);
+
+    column(orbits.entity);
+    column(orbits.parent);
+    column(orbits.elapsedTime);
+    column(orbits.radius);
+    column(orbits.orbitalVelocity);
+    column(orbits.period);
+    column(orbits.insertionAngle);
+    column(orbits.clockwise);
+
+    for (std::uint64_t seed : backgroundSeeds) {
+        const std::uint32_t halves[2] = {
+            static_cast<std::uint32_t>(seed & 0xFFFFFFFF),
+            static_cast<std::uint32_t>(seed >> 32)
+        };
+        visitor(halves, 2);
+    }
+    column(playerStatus);
+}
+
+void Snapshot::pack(std::vector<std::uint32_t>& words) const {
+    words.clear();
+    words.reserve(packedSize());
+    forEachRun([&words](const void* run, std::size_t count) {
+        const std::size_t offset = words.size();
+        words.resize(offset + count);
+        std::memcpy(&words[offset], run, count * 4);
+    });
+}
+
+void Snapshot::xorInto(std::vector<std::uint32_t>& words) const {
+    std::size_t offset = 0;
+    forEachRun([&words, &offset](const void* run, std::size_t count) {
+        const char* bytes = static_cast<const char*>(run);
+        for (std::size_t i = 0; i < count && offset + i < words.size(); ++i) {
+            std::uint32_t word;
+            std::memcpy(&word, bytes + i*4, 4);
+            words[offset + i] ^= word;
+        }
+        offset += count;
+    });
+}
+
+bool Snapshot::unpack(const std::vector<std::uint32_t>& words) {
+    if (words.size() < CountWords)
+        return false;
+    const std::uint64_t n = words[0];
+    const std::uint64_t m = words[1];
+    const std::uint64_t s = words[2];
+    const std::uint64_t p = words[3];
+    if (CountWords + n*8 + m*8 + s*2 + p != words.size()) {
+        std::cerr << "Snapshot has inconsistent size" << std::endl;
+        return false;
+    }
+
+    // Validated before anything is assigned so that a bad snapshot leaves this one unchanged
+    const std::size_t orbitEntities = CountWords + n*8;
+    const std::size_t orbitParents = orbitEntities + m;
+    for (std::size_t i = 0; i < m; ++i) {
+        if (words[orbitEntities + i] >= n || words[orbitParents + i] >= n) {
+            std::cerr << "Snapshot has invalid orbit" << std::endl;
+            return false;
+        }
+    }
+
+    std::memcpy(&raceTime, &words[4], 4);
+
+    std::size_t offset = CountWords;
+    readColumn(words, offset, nameHash, n);
+    readColumn(words, offset, x, n);
+    readColumn(words, offset, y, n);
+    readColumn(words, offset, vx, n);
+    readColumn(words, offset, vy, n);
+    readColumn(words, offset, rotation, n);
+    readColumn(words, offset, frame, n);
+    readColumn(words, offset, motionType, n);
+
+    readColumn(words, offset, orbits.entity, m);
+    readColumn(words, offset, orbits.parent, m);
+    readColumn(words, offset, orbits.elapsedTime, m);
+    readColumn(words, offset, orbits.radius, m);
+    readColumn(words, offset, orbits.orbitalVelocity, m);
+    readColumn(words, offset, orbits.period, m);
+    readColumn(words, offset, orbits.insertionAngle, m);
+    readColumn(words, offset, orbits.clockwise, m);
+
+    backgroundSeeds.resize(s);
+    for (unsigned int i = 0; i < s; ++i, offset += 2)
+        backgroundSeeds[i] = words[offset] | (static_cast<std::uint64_t>(words[offset+1]) << 32);
+    readColumn(words, offset, playerStatus, p);
+    return true;
+}
+
+std::uint32_t Snapshot::checksum() const {
+    std::vector<std::uint32_t>& words = scratch.words;
+    pack(words);
+    const std::size_t frames = CountWords + entityCount() * 6;
+    std::fill(words.begin() + frames, words.begin() + frames + entityCount(), 0);
+
+    std::uint32_t hash = 2166136261u;
+    for (std::uint32_t word : words) {
+        for (unsigned int i = 0; i < 4; ++i) {
+            hash ^= (word >> (i*8)) & 0xFF;
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
+bool Snapshot::encode(std::vector<std::uint8_t>& output, const Snapshot* base) const {
+    std::vector<std::uint32_t>& words = scratch.words;
+    pack(words);
+
+    bool delta = false;
+    if (base && base->packedSize() == words.size()) {
+        base->xorInto(words);
+        delta = true;
+    }
+
+    output.clear();
+    ByteWriter writer(output);
+    writer.bytes(Magic, 4);
+    writer.u16(Version);
+    writer.u16(delta ? DeltaFlag : 0);
+    writer.u32(words.size());
+
+    // Byte plane b of word i is at b*n + i. Zero runs and literal runs alternate
+    const std::size_t n = words.size();
+    const std::size_t total = n * 4;
+    auto byteAt = [&words, n](std::size_t i) -> std::uint8_t {
+        return (words[i % n] >> ((i / n) * 8)) & 0xFF;
+    };
+    std::size_t i = 0;
+    while (i < total) {
+        std::size_t zeros = 0;
+        while (i + zeros < total && byteAt(i + zeros) == 0)
+            ++zeros;
+        i += zeros;
+
+        std::size_t literals = 0;
+        while (i + literals < total && (byteAt(i + literals) != 0 ||
+               (i + literals + 1 < total && byteAt(i + literals + 1) != 0)))
+            ++literals;
+
+        writer.varint(zeros);
+        writer.varint(literals);
+        for (std::size_t j = 0; j < literals; ++j)
+            writer.u8(byteAt(i + j));
+        i += literals;
+    }
+    return delta;
+}
+
+bool Snapshot::decode(const std::uint8_t* data, std::size_t size, const Snapshot* base) {
+    if (size < HeaderSize || std::memcmp(data, Magic, 4) != 0) {
+        std::cerr << "Data is not a snapshot" << std::endl;
+        return false;
+    }
+    ByteReader reader(data + 4, size - 4);
+    const std::uint16_t version = reader.u16();
+    const std::uint16_t flags = reader.u16();
+    if (version != Version) {
+        std::cerr << "Unsupported snapshot version " << version << std::endl;
+        return false;
+    }
+    const std::size_t n = reader.u32();
+    if (n > MaxWords) {
+        std::cerr << "Snapshot is too large" << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint32_t>& words = scratch.words;
+    words.assign(n, 0);
+    const std::size_t total = n * 4;
+    std::size_t i = 0;
+    while (i < total) {
+        const std::uint32_t zeros = reader.varint();
+        const std::uint32_t literals = reader.varint();
+        if (reader.hasFailed() || i + zeros + literals > total || reader.remaining() < literals) {
+            std::cerr << "Snapshot is corrupt" << std::endl;
+            return false;
+        }
+        i += zeros;
+        for (std::uint32_t j = 0; j < literals; ++j, ++i)
+            words[i % n] |= static_cast<std::uint32_t>(reader.u8()) << ((i / n) * 8);
+    }
+
+    if (flags & DeltaFlag) {
+        if (!base) {
+            std::cerr << "Delta snapshot decoded without a base" << std::endl;
+            return false;
+        }
+        if (base->packedSize() != words.size()) {
+            std::cerr << "Delta snapshot does not match its base" << std::endl;
+            return false;
+        }
+        base->xorInto(words);
+    }
+
+    return unpack(words);
+}
+
+bool Snapshot::save(const std::string& file) const {
+    std::vector<std::uint8_t> data;
+    encode(data);
+    std::ofstream output(file.c_str(), std::ios::binary);
+    output.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!output.good()) {
+        std::cerr << "Failed to write snapshot: " << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool Snapshot::load(const std::string& file) {
+    std::ifstream input(file.c_str(), std::ios::binary);
+    if (!input.good()) {
+        std::cerr << "Failed to open snapshot: " << file << std::endl;
+        return false;
+    }
+    const std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    return decode(data.data(), data.size());
+}
\ No newline at end of file
@@ -0,0 +1,132 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Simulation state of an Environment at one point in time. State is kept as parallel arrays, one
+ * per field, so that packing is a straight copy of each array
+ *
+ * Encoded snapshots are a short header followed by the packed state. The state is packed into 32
+ * bit words and split into byte planes, so bytes that rarely change (the high bytes of floats) end
+ * up next to each other. When a base snapshot with the same layout is given the words are XORed
+ * with it first, so unchanged values become zero. Runs of zero bytes are then run length encoded.
+ * Consecutive ticks typically encode to a small fraction of the raw size
+ *
+ * Encoding reuses buffers kept in the snapshot, so a snapshot must not be encoded or used as a
+ * base on two threads at once
+ */
+class Snapshot {
+public:
+    /**
+     * State of entities on orbits. Indices refer to the entity arrays
+     */
+    struct Orbits {
+        std::vector<std::uint32_t> entity;
+        std::vector<std::uint32_t> parent;
+        std::vector<float> elapsedTime;
+        std::vector<float> radius;
+        std::vector<float> orbitalVelocity;
+        std::vector<float> period;
+        std::vector<float> insertionAngle;
+        std::vector<std::uint32_t> clockwise;
+    };
+
+    std::vector<std::uint32_t> playerStatus; // one per player, in player order
+    float raceTime = 0;
+
+    // Entity state, parallel
+    std::vector<std::uint32_t> nameHash;
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> rotation;
+    std::vector<std::uint32_t> frame;
+    std::vector<std::uint32_t> motionType;
+
+    Orbits orbits;
+    std::vector<std::uint64_t> backgroundSeeds;
+
+    /**
+     * Sets the number of entities and clears the orbits
+     */
+    void resize(unsigned int entityCount);
+
+    /**
+     * Returns the number of entities in the snapshot
+     */
+    unsigned int entityCount() const;
+
+    /**
+     * Hash used to check that entities match when restoring
+     */
+    static std::uint32_t hashName(const std::string& name);
+
+    /**
+     * Hash of the simulation state, for checking that two runs agree. Animation frames are left
+     * out since headless runs do not advance them
+     */
+    std::uint32_t checksum() const;
+
+    /**
+     * Encodes the snapshot, optionally as a delta against another
+     *
+     * \param output Buffer to write to. Cleared first
+     * \param base Snapshot to encode against, normally the previous one. May be null
+     * \return True if encoded as a delta. Full snapshots are written when the layouts differ
+     */
+    bool encode(std::vector<std::uint8_t>& output, const Snapshot* base = nullptr) const;
+
+    /**
+     * Decodes a snapshot produced by encode()
+     *
+     * \param data The encoded snapshot
+     * \param size The size of the data in bytes
+     * \param base The snapshot it was encoded against. Required for delta snapshots
+     * \return True on success
+     */
+    bool decode(const std::uint8_t* data, std::size_t size, const Snapshot* base = nullptr);
+
+    /**
+     * Writes the snapshot to a file as a full snapshot
+     */
+    bool save(const std::string& file) const;
+
+    /**
+     * Reads a snapshot written by save()
+     */
+    bool load(const std::string& file);
+
+private:
+    /**
+     * Packed words reused between calls. Copies start empty so that copying a snapshot only
+     * copies its state
+     */
+    struct Scratch {
+        std::vector<std::uint32_t> words;
+
+        Scratch() = default;
+        Scratch(const Scratch&) {}
+        Scratch& operator=(const Scratch&) { return *this; }
+    };
+
+    mutable Scratch scratch;
+
+    std::size_t packedSize() const;
+    void pack(std::vector<std::uint32_t>& words) const;
+    bool unpack(const std::vector<std::uint32_t>& words);
+
+    /**
+     * XORs the packed form of this snapshot into words of the same layout without packing it
+     */
+    void xorInto(std::vector<std::uint32_t>& words) const;
+
+    /**
+     * Calls the visitor with each run of packed words, in packing order
+     */
+    template<typename F>
+    void forEachRun(F visitor) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include <Headless/Benchmark.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <SFML/System.hpp>
+#include <Entities/Entity.hpp>
+#include <Environment/Environment.hpp>
+#include <Environment/GhostTrack.hpp>
+#include <Environment/RewindBuffer.hpp>
+#include <Media/CountingRenderTarget.hpp>
+#include <Properties.hpp>
+#include <Util/JsonFile.hpp>
+#include <Util/JSON/JsonLoader.hpp>
+#include <Util/Random.hpp>
+#include <Util/Util.hpp>
+
+// Keeps timed calls from being inlined into the loop and optimized away
+#ifdef _MSC_VER
+#define BENCHMARK_NOINLINE __declspec(noinline)
+#else
+#define BENCHMARK_NOINLINE __attribute__((noinline))
+#endif
+
+namespace {
+const std::uint64_t Seed = 1;
+const float TickLength = 1.0f / 120.0f;
+const float FieldSize = 20000;
+const unsigned int GravityInterval = 16; // one in this many entities emits gravity
+const std::size_t RewindBudget = 64 * 1024 * 1024;
+const unsigned int RewindKeyframeInterval = 30;
+const unsigned int GhostCount = 500;
+const float GhostSpread = 400; // around the camera so that they are all drawn
+const unsigned int JsonLoads = 5;
+
+EntitySpec makeSpec(unsigned int i) {
+    EntitySpec spec;
+    spec.name = "Bench" + intToString(i);
+    spec.gfx = "Planets/earth.anim";
+    spec.x = randomFloat(0, FieldSize);
+    spec.y = randomFloat(0, FieldSize);
+    spec.vx = randomFloat(-20, 20);
+    spec.vy = randomFloat(-20, 20);
+    spec.hasGravity = i % GravityInterval == 0;
+    spec.canMove = !spec.hasGravity;
+    spec.mass = spec.hasGravity ? randomFloat(1000, 100000) : randomFloat(1, 10);
+    return spec;
+}
+
+// Mirrors the old signature, which took both entities by value
+BENCHMARK_NOINLINE void applyGravityByValue(Entity::Ptr source, Entity::Ptr target) {
+    source->applyGravityToEntity(*target);
+}
+
+void report(const std::string& label, sf::Time elapsed, unsigned int ticks) {
+    std::cout << "  " << label << ": " << elapsed.asMicroseconds() / ticks << " us/tick" << std::endl;
+}
+
+// Environment file with the given number of entities, in the same layout as the real ones
+void writeEnvironmentJson(const std::string& file, unsigned int entityCount) {
+    std::ofstream output(file.c_str());
+    output << "{\n    \"name\": \"Benchmark\",\n    \"width\": " << FieldSize << ",\n    \"height\": " << FieldSize
+           << ",\n    \"entities\": [\n";
+    for (unsigned int i = 0; i < entityCount; ++i) {
+        const EntitySpec spec = makeSpec(i);
+        output << "        {\n            \"name\": \"" << spec.name << "\",\n            \"gfx\": \"" << spec.gfx
+               << "\",\n            \"x\": " << spec.x << ",\n            \"y\": " << spec.y
+               << ",\n            \"vx\": " << spec.vx << ",\n            \"vy\": " << spec.vy
+               << ",\n            \"mass\": " << spec.mass
+               << ",\n            \"canMove\": " << (spec.canMove ? "true" : "false")
+               << ",\n            \"hasGravity\": " << (spec.hasGravity ? "true" : "false")
+               << "\n        }" << (i + 1 < entityCount ? "," : "") << "\n";
+    }
+    output << "    ]\n}\n";
+}
+}
+
+int Benchmark::run(unsigned int entityCount, unsigned int ticks) {
+    if (entityCount == 0 || ticks == 0) {
+        std::cerr << "Benchmark needs at least one entity and one tick" << std::endl;
+        return 1;
+    }
+
+    // Fixed seed so that runs place the same entities
+    Random::setSeed(Seed);
+    std::cout << "Benchmarking " << entityCount << " entities over " << ticks << " ticks" << std::endl;
+
+    // Json parsing into the per file arena sized from the input, and the same parse into an
+    // arena that grows as it goes
+    const std::string jsonFile = Properties::GameSavePath+"benchmark.json";
+    writeEnvironmentJson(jsonFile, entityCount);
+    sf::Clock jsonClock;
+    for (unsigned int i = 0; i < JsonLoads; ++i)
+        JsonFile file(jsonFile);
+    const sf::Time arenaLoad = jsonClock.restart();
+    for (unsigned int i = 0; i < JsonLoads; ++i) {
+        JsonLoader loader(jsonFile);
+        JsonGroup::load(loader);
+    }
+    const sf::Time growingLoad = jsonClock.restart();
+    std::remove(jsonFile.c_str());
+    std::cout << "  Json load, arena: " << arenaLoad.asMicroseconds() / JsonLoads / 1000 << " ms" << std::endl;
+    std::cout << "  Json load, growing arena: " << growingLoad.asMicroseconds() / JsonLoads / 1000 << " ms" << std::endl;
+
+    // The file used the random stream, start over so the entities match earlier runs
+    Random::setSeed(Seed);
+
+    std::vector<Entity::Ptr> entities;
+    entities.reserve(entityCount);
+    for (unsigned int i = 0; i < entityCount; ++i)
+        entities.push_back(Entity::create(makeSpec(i)));
+
+    sf::Clock clock;
+    for (unsigned int t = 0; t < ticks; ++t) {
+        for (Entity::Ptr entity : entities) {
+            for (Entity::Ptr gravEnt : entities)
+                applyGravityByValue(gravEnt, entity);
+            entity->update(TickLength);
+        }
+    }
+    const sf::Time owning = clock.restart();
+
+    for (unsigned int t = 0; t < ticks; ++t) {
+        for (const Entity::Ptr& entity : entities) {
+            for (const Entity::Ptr& gravEnt : entities)
+                gravEnt->applyGravityToEntity(*entity);
+            entity->update(TickLength);
+        }
+    }
+    const sf::Time borrowed = clock.restart();
+
+    report("Gravity pass, shared_ptr copies", owning, ticks);
+    report("Gravity pass, non-owning", borrowed, ticks);
+    if (borrowed > sf::Time::Zero)
+        std::cout << "  Speedup: " << owning.asSeconds() / borrowed.asSeconds() << "x" << std::endl;
+    entities.clear();
+
+    EnvironmentSpec spec;
+    spec.name = "Benchmark";
+    spec.width = spec.height = FieldSize;
+    spec.playerSpawn.x = spec.playerSpawn.y = FieldSize / 2;
+    spec.entities.reserve(entityCount);
+    for (unsigned int i = 0; i < entityCount; ++i)
+        spec.entities.push_back(makeSpec(i));
+    Environment environment(spec);
+
+    clock.restart();
+    for (unsigned int t = 0; t < ticks; ++t)
+        environment.update(TickLength);
+    report("Environment tick", clock.getElapsedTime(), ticks);
+
+    environment.setAnimationsEnabled(false);
+    clock.restart();
+    for (unsigned int t = 0; t < ticks; ++t)
+        environment.update(TickLength);
+    report("Environment tick without animations", clock.getElapsedTime(), ticks);
+    environment.setAnimationsEnabled(true);
+
+    // Same ticks again with every tick sampled for rewind
+    RewindBuffer rewind(RewindBudget, 1, RewindKeyframeInterval);
+    clock.restart();
+    for (unsigned int t = 0; t < ticks; ++t) {
+        environment.update(TickLength);
+        rewind.record(environment);
+    }
+    report("Environment tick with rewind", clock.getElapsedTime(), ticks);
+    std::cout << "  Rewind: " << rewind.getSampleCount() << " samples in "
+              << rewind.getMemoryUsage() / 1024 << " KB" << std::endl;
+    if (rewind.stepBack(environment, ticks / 2))
+        std::cout << "  Rewind restore: " << rewind.getLastRestoreTime().asMicroseconds() << " us" << std::endl;
+
+    // Rendering goes to an offscreen texture so no window is needed
+    sf::RenderTexture texture;
+    if (!texture.create(Properties::ScreenWidth, Properties::ScreenHeight)) {
+        std::cerr << "Skipping render benchmark, failed to create render texture" << std::endl;
+        return 0;
+    }
+    CountingRenderTarget target(texture);
+
+    clock.restart();
+    for (unsigned int t = 0; t < ticks; ++t) {
+        environment.render(target);
+        texture.display();
+    }
+    report("Environment render", clock.getElapsedTime(), ticks);
+
+    const CountingRenderTarget::Stats stats = target.endFrame();
+    std::cout << "  Per frame: " << stats.drawCalls / ticks << " draw calls, " << stats.vertices / ticks
+              << " vertices, " << stats.textureSwitches / ticks << " texture switches, "
+              << stats.stateChanges / ticks << " state changes" << std::endl;
+
+    // Leaderboard sized crowd of ghosts wandering around the player
+    for (unsigned int i = 0; i < GhostCount; ++i) {
+        GhostTrack::Ptr track = GhostTrack::create();
+        GhostTrack::Sample sample;
+        sample.position = {
+            FieldSize / 2 + randomFloat(-GhostSpread, GhostSpread),
+            FieldSize / 2 + randomFloat(-GhostSpread, GhostSpread)
+        };
+        const sf::Vector2f velocity(randomFloat(-50, 50), randomFloat(-50, 50));
+        for (unsigned int t = 0; t <= ticks * 4; ++t) {
+            sample.time = t * TickLength;
+            sample.position += velocity * TickLength;
+            sample.rotation += 90 * TickLength;
+            track->record(sample);
+        }
+        environment.addGhost(track);
+    }
+
+    clock.restart();
+    for (unsigned int t = 0; t < ticks; ++t) {
+        environment.update(TickLength);
+        environment.render(target);
+        texture.display();
+    }
+    report("Environment tick and render with " + intToString(GhostCount) + " ghosts", clock.getElapsedTime(), ticks);
+
+    const CountingRenderTarget::Stats ghostStats = target.endFrame();
+    std::cout << "  Per frame: " << ghostStats.drawCalls / ticks << " draw calls, "
+              << ghostStats.vertices / ticks << " vertices" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+/**
+ * Headless benchmarks for the simulation. Run with the --benchmark command line option. No window
+ * is created and results are printed to stdout
+ */
+class Benchmark {
+public:
+    /**
+     * Times the gravity and update pass over a field of entities. The pass is run once iterating
+     * the way it used to, copying shared pointers for every pair, and once through the non-owning
+     * Entity API. A full Environment tick and render over the same number of entities are then
+     * timed, along with the draw calls and vertices issued per frame. The tick is timed again while
+     * recording every tick for rewind, and the memory used and the time to restore are reported.
+     * Loading an environment file with as many entities is timed with and without the json arena
+     *
+     * \param entityCount The number of entities to simulate
+     * \param ticks The number of ticks to time for each pass
+     * \return The process exit code
+     */
+    static int run(unsigned int entityCount, unsigned int ticks);
+
+private:
+    Benchmark() = delete;
+};
+
+#endif
\ No newline at end of file
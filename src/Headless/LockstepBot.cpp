@@ -0,0 +1,90 @@
+#include <Headless/LockstepBot.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <SFML/System.hpp>
+#include <Environment/Environment.hpp>
+#include <Network/LockstepController.hpp>
+#include <Network/LockstepRunner.hpp>
+#include <Properties.hpp>
+#include <Util/Random.hpp>
+
+namespace {
+const sf::Time Timeout = sf::seconds(10);
+const sf::Time Linger = sf::seconds(1); // keeps answering peers that are still finishing
+const unsigned int InputHold = 30; // ticks each random input is held for
+}
+
+int LockstepBot::run(const LockstepSession::Config& config, unsigned int ticks, unsigned int resimulationBudget) {
+    LockstepSession::Ptr session = LockstepSession::create(config);
+    if (!session)
+        return 1;
+
+    Random::setSeed(config.seed);
+    Environment environment("test.json");
+    environment.setAnimationsEnabled(false);
+    environment.setStreaming(Environment::Resident);
+    LockstepController::setupPlayers(environment, session);
+    LockstepRunner runner(environment, session, resimulationBudget);
+
+    // Input comes from a stream of its own so that it does not disturb the simulation's
+    Random inputs(config.seed, 1000 + config.playerId);
+    InputFrame input;
+    unsigned int inputTicks = 0;
+    auto nextInput = [&]() {
+        if (inputTicks++ % InputHold == 0)
+            input.buttons = static_cast<std::uint8_t>(inputs.next());
+        return input;
+    };
+
+    std::cout << "Player " << config.playerId << " of " << config.playerCount << " running "
+              << ticks << " ticks on port " << config.port << std::endl;
+    sf::Clock clock;
+    sf::Clock stall;
+    unsigned int rollbacks = 0, resimulated = 0, maxResimulated = 0;
+
+    // Runs in real time until every player's input for every tick is in and no rollback is left
+    while (runner.getPresentTick() < ticks || session->getConfirmedTick() < ticks ||
+           session->getTick() < runner.getPresentTick() ||
+           session->getRollbackTick() != LockstepSession::NoRollback) {
+        const unsigned int due = clock.getElapsedTime().asSeconds() / Properties::FixedTickLength;
+        const unsigned int present = runner.getPresentTick();
+        const unsigned int newTicks = std::min(due, ticks) > present ? std::min(due, ticks) - present : 0;
+        const LockstepRunner::Stats stats = runner.update(newTicks, nextInput);
+        if (runner.hasFailed())
+            return 1;
+
+        rollbacks += stats.rollbacks;
+        resimulated += stats.resimulated;
+        maxResimulated = std::max(maxResimulated, stats.resimulated);
+        if (stats.simulated > 0 || stats.resimulated > 0)
+            stall.restart();
+        else if (stall.getElapsedTime() > Timeout) {
+            std::cerr << "Timed out waiting for players at tick " << session->getTick() << std::endl;
+            return 1;
+        }
+        sf::sleep(sf::milliseconds(1));
+    }
+    const sf::Time elapsed = clock.getElapsedTime();
+
+    sf::Clock linger;
+    while (linger.getElapsedTime() < Linger) {
+        session->poll();
+        sf::sleep(sf::milliseconds(5));
+    }
+
+    std::cout << "  Time: " << elapsed.asMilliseconds() << " ms" << std::endl;
+    std::cout << "  Rollbacks: " << rollbacks << ", " << resimulated << " ticks simulated again, at most "
+              << maxResimulated << " in one update" << std::endl;
+    std::cout << "  Player status:";
+    for (unsigned int i = 0; i < config.playerCount; ++i)
+        std::cout << " " << environment.getPlayerStatus(i);
+    std::cout << std::endl;
+    std::cout << "  State checksum: " << std::hex << runner.getState(ticks).checksum() << std::dec << std::endl;
+    if (session->hasDesynced()) {
+        std::cout << "  Desynced at tick " << session->getDesyncTick() << std::endl;
+        return 2;
+    }
+    std::cout << "  In sync" << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,28 @@
+#ifndef LOCKSTEPBOT_HPP
+#define LOCKSTEPBOT_HPP
+
+#include <Network/LockstepSession.hpp>
+
+/**
+ * Headless player for testing networked races without windows. Run several with the --lockstep
+ * command line option and --bot on loopback, optionally over a simulated poor network. Each bot
+ * presses buttons from a random sequence of its own in real time and reports the rollbacks it
+ * made and the final state hash, which must match across all of them
+ */
+class LockstepBot {
+public:
+    /**
+     * Plays the given number of ticks
+     *
+     * \param config The session to join
+     * \param ticks The number of ticks to simulate
+     * \param resimulationBudget Most ticks simulated again per update after a rollback
+     * \return The process exit code. Non-zero if the session desynced or timed out
+     */
+    static int run(const LockstepSession::Config& config, unsigned int ticks, unsigned int resimulationBudget);
+
+private:
+    LockstepBot() = delete;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <Headless/Replay.hpp>
+
+#include <iostream>
+#include <SFML/System.hpp>
+#include <Entities/Controllers/InputRecording.hpp>
+#include <Entities/Controllers/ReplayController.hpp>
+#include <Environment/Environment.hpp>
+#include <Environment/Snapshot.hpp>
+#include <Util/Profiler.hpp>
+#include <Util/Random.hpp>
+
+int Replay::run(const std::string& file) {
+    InputRecording::Ptr recording = InputRecording::load(file);
+    if (!recording)
+        return 1;
+    if (recording->getTickLength() <= 0) {
+        std::cerr << "Recording has no tick length: " << file << std::endl;
+        return 1;
+    }
+
+    // Same seed as the recorded run so that anything random comes out the same
+    Random::setSeed(recording->getSeed());
+    Environment environment(recording->getEnvironmentFile());
+    environment.setPlayerController(ReplayController::create(recording));
+    environment.setAnimationsEnabled(false);
+    environment.setStreaming(Environment::Synchronous);
+
+    std::cout << "Replaying " << recording->size() << " ticks in " << recording->getEnvironmentFile() << std::endl;
+    sf::Clock clock;
+    for (unsigned int t = 0; t < recording->size(); ++t) {
+        environment.update(recording->getTickLength());
+        Profiler::get().endFrame();
+    }
+    const sf::Time elapsed = clock.getElapsedTime();
+
+    Snapshot state;
+    environment.saveState(state);
+
+    std::cout << "  Time: " << elapsed.asMilliseconds() << " ms";
+    if (recording->size() > 0)
+        std::cout << ", " << elapsed.asMicroseconds() / recording->size() << " us/tick";
+    std::cout << std::endl;
+    std::cout << "  Player status: " << environment.getPlayerStatus() << std::endl;
+    std::cout << "  State checksum: " << std::hex << state.checksum() << std::dec << std::endl;
+
+    Profiler::get().exportChromeTrace(file + ".trace.json");
+
+    if (recording->hasFinalChecksum() && recording->getFinalChecksum() != state.checksum()) {
+        std::cerr << "Replay diverged from the recording, which ended with checksum " << std::hex
+                  << recording->getFinalChecksum() << std::dec << std::endl;
+        return 1;
+    }
+    return 0;
+}
\ No newline at end of file
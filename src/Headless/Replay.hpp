@@ -0,0 +1,26 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <string>
+
+/**
+ * Headless playback of input recordings. Run with the --replay command line option. The run is
+ * simulated at the recorded tick length without a window, so replays of the same recording give
+ * the same state and can be profiled and compared between builds
+ */
+class Replay {
+public:
+    /**
+     * Plays back the recording and prints the timing, the final player state and a checksum of
+     * the final simulation state. Profiler zones are written next to the recording
+     *
+     * \param file The recording to play, written by running with --record
+     * \return The process exit code. Non zero if the final state does not match the recording
+     */
+    static int run(const std::string& file);
+
+private:
+    Replay() = delete;
+};
+
+#endif
\ No newline at end of file
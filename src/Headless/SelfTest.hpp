@@ -0,0 +1,21 @@
+#ifndef SELFTEST_HPP
+#define SELFTEST_HPP
+
+/**
+ * Headless checks of behaviour that is easy to break and hard to notice in play. Run with the
+ * --selftest command line option. Each failed check is printed to stderr
+ */
+class SelfTest {
+public:
+    /**
+     * Runs every check
+     *
+     * \return The process exit code. Non zero if any check failed
+     */
+    static int run();
+
+private:
+    SelfTest() = delete;
+};
+
+#endif
\ No newline at end of file
@@ -1,7 +1,6 @@
 #include <Media/Animation.hpp>
 #include <Util/BinaryFile.hpp>
 #include <Util/ResourcePool.hpp>
-#include <Util/Timer.hpp>
 #include <Properties.hpp>
 #include <iostream>
 using namespace std;
@@ -24,39 +23,24 @@ AnimationSource::~AnimationSource()
 
 void AnimationSource::load(const string& file)
 {
-    BinaryFile input(file);
-    AnimationFrame temp;
-    int maxL = 0;
+    AnimationFormat::Data data;
+    AnimationFormat::load(file, data);
     string path = BinaryFile::getPath(file);
 
-    spriteSheetFile = input.getString();
+    spriteSheetFile = data.spritesheet;
     if (BinaryFile::exists(path+spriteSheetFile))
 		sheet = imagePool.loadResource(path+spriteSheetFile);
 	else if (BinaryFile::exists(Properties::SpriteSheetPath+spriteSheetFile))
 		sheet = imagePool.loadResource(Properties::SpriteSheetPath+spriteSheetFile);
-    loop = bool(input.get<uint8_t>());
-    int numFrames = input.get<uint16_t>();
-    frames.resize(numFrames);
-    for (int i = 0; i<numFrames; ++i)
+    loop = data.loop;
+    frames.swap(data.frames);
+    pieces.swap(data.pieces);
+
+    unsigned int maxL = 0;
+    for (unsigned int i = 0; i<frames.size(); ++i)
     {
-        temp.length = input.get<uint32_t>();
-        int n = input.get<uint16_t>();
-        for (int j = 0; j<n; ++j)
-        {
-        	temp.sourcePos.x = input.get<uint32_t>();
-			temp.sourcePos.y = input.get<uint32_t>();
-			temp.size.x = input.get<uint32_t>();
-			temp.size.y = input.get<uint32_t>();
-			temp.scaleX = double(input.get<uint32_t>())/100;
-			temp.scaleY = double(input.get<uint32_t>())/100;
-			temp.renderOffset.x = input.get<int32_t>();
-			temp.renderOffset.y = input.get<int32_t>();
-			temp.rotation = input.get<uint32_t>();
-			temp.alpha = input.get<uint8_t>();
-			frames[i].push_back(temp);
-        }
-        if (n>maxL)
-			maxL = n;
+        if (frames[i].pieceCount>maxL)
+			maxL = frames[i].pieceCount;
     }
     sprites.reserve(maxL);
 }
@@ -73,20 +57,22 @@ const std::vector<sf::Sprite>& AnimationSource::getFrame(
         return sprites;
     }
 
-	sprites.resize(frames[i].size());
-	for (unsigned int j = 0; j<frames[i].size(); ++j)
+	const AnimationFormat::Frame& frame = frames[i];
+	sprites.resize(frame.pieceCount);
+	for (unsigned int j = 0; j<frame.pieceCount; ++j)
     {
+    	const AnimationFormat::Piece& piece = pieces[frame.firstPiece+j];
     	Sprite sp;
     	sp.setTexture(*sheet,true);
-    	sp.setTextureRect(IntRect(frames[i][j].sourcePos.x, frames[i][j].sourcePos.y, frames[i][j].size.x, frames[i][j].size.y));
-		sp.setOrigin(frames[i][j].size.x/2,frames[i][j].size.y/2);
-		sp.setColor(Color(255,255,255,frames[i][j].alpha));
-		sp.setScale(frames[i][j].scaleX * scale.x, frames[i][j].scaleY * scale.y);
+    	sp.setTextureRect(IntRect(piece.sourceX, piece.sourceY, piece.width, piece.height));
+		sp.setOrigin(piece.width/2,piece.height/2);
+		sp.setColor(Color(255,255,255,piece.alpha));
+		sp.setScale(piece.scaleX * scale.x, piece.scaleY * scale.y);
 		sf::Vector2f offset = Vector2f(sp.getGlobalBounds().width/2,sp.getGlobalBounds().height/2) - sp.getOrigin();
 		if (!centerOrigin)
             offset = -sp.getOrigin();
-		sp.setRotation(frames[i][j].rotation + rot);
-		sp.setPosition(pos+frames[i][j].renderOffset-offset);
+		sp.setRotation(piece.rotation + rot);
+		sp.setPosition(pos+Vector2f(piece.offsetX,piece.offsetY)-offset);
 		sprites[j] = sp;
     }
     return sprites;
@@ -114,27 +100,24 @@ sf::Vector2f AnimationSource::getFrameSize(unsigned int n) {
     return sf::Vector2f(bounds.width - bounds.left, bounds.height - bounds.top);
 }
 
-unsigned int AnimationSource::incFrame(unsigned int cFrm, unsigned long lTime)
+unsigned int AnimationSource::incFrame(unsigned int cFrm, float& elapsed)
 {
     if (cFrm>=frames.size()) {
         return 0;
     }
 
-	if (frames[cFrm].size()==0) //current frame is empty, go to next
+	if (frames[cFrm].pieceCount==0) //current frame is empty, go to next
 	{
 		if (cFrm+1<frames.size())
 			return cFrm+1;
 		return cFrm;
 	}
 
-    if (Timer::get().timeElapsedMilliseconds()-lTime>=frames[cFrm][0].length)
+    const float length = frames[cFrm].length / 1000.0f;
+    if (elapsed>=length && (cFrm+1<frames.size() || loop))
     {
-        if (cFrm+1<frames.size())
-            return cFrm+1;
-        else if (loop)
-            return 0;
-        else
-            return cFrm;
+        elapsed -= length;
+        return cFrm+1<frames.size() ? cFrm+1 : 0;
     }
 
     return cFrm;
@@ -156,7 +139,8 @@ bool AnimationSource::spritesheetFound() const {
 Animation::Animation() : scale(1,1)
 {
     rotation = 0;
-    curFrm = lastFrmChangeTime = 0;
+    curFrm = 0;
+    frameTime = 0;
     playing = false;
     isCenterOrigin = false;
     looping = false;
@@ -182,21 +166,27 @@ void Animation::setSource(AnimationReference src, bool co)
 {
     animSrc = src;
     curFrm = 0;
-    lastFrmChangeTime = Timer::get().timeElapsedMilliseconds();
+    frameTime = 0;
     looping = animSrc->isLooping();
     isCenterOrigin = co;
 }
 
-void Animation::update() const
+void Animation::update(float dt) const
 {
     if (!animSrc)
         return;
 
-    unsigned int t = curFrm;
     if (playing || isLooping())
-        curFrm = animSrc->incFrame(curFrm,lastFrmChangeTime);
-    if (t!=curFrm)
-        lastFrmChangeTime = Timer::get().timeElapsedMilliseconds();
+    {
+        frameTime += dt;
+        for (unsigned int i = 0; i<animSrc->numFrames(); ++i) //bounded in case no frame has a length
+        {
+            const unsigned int next = animSrc->incFrame(curFrm,frameTime);
+            if (next==curFrm)
+                break;
+            curFrm = next;
+        }
+    }
 
     if (curFrm==animSrc->numFrames()-1 && playing)
     {
@@ -210,7 +200,7 @@ void Animation::update() const
 void Animation::setFrame(unsigned int frm) const
 {
     curFrm = frm;
-    lastFrmChangeTime = Timer::get().timeElapsedMilliseconds();
+    frameTime = 0;
     playing = false;
 }
 
@@ -270,12 +260,11 @@ void Animation::setRotation(float angle) {
     rotation = angle;
 }
 
-void Animation::draw(sf::RenderTarget& window) const
+void Animation::draw(CountingRenderTarget& window) const
 {
     if (!animSrc)
         return;
 
-    update();
     const std::vector<Sprite>& t = animSrc->getFrame(curFrm, position, scale, rotation, isCenterOrigin);
     for (unsigned int i = 0; i<t.size(); ++i)
 		window.draw(t[i]);
@@ -2,24 +2,13 @@
 #define ANIMATION_HPP
 
 #include <SFML/Graphics.hpp>
+#include <Media/AnimationFormat.hpp>
+#include <Media/CountingRenderTarget.hpp>
 #include <string>
 #include <memory>
 
 typedef std::shared_ptr<sf::Texture> TextureReference;
 
-/**
- * Data structure to store information about individual frames in an animation
- *
- * \ingroup Media
- */
-struct AnimationFrame
-{
-    sf::Vector2f sourcePos, size, renderOffset;
-    unsigned int length;
-    int rotation, alpha;
-    double scaleX,scaleY;
-};
-
 /**
  * This class handles the loading and storage of animation data. This enables the flyweight pattern
  * to be utilized when used in conjunction with the Animation class
@@ -47,7 +36,7 @@ public:
     ~AnimationSource();
 
     /**
-     * Loads an animation from the given file
+     * Loads an animation from the given file. Both v1 and v2 files are supported
      *
      * \param file The full path of the file to load
      */
@@ -79,10 +68,10 @@ public:
      * Given the current frame and elapsed time, combined with internal animation data, returns the new frame
      *
      * \param cFrm The current frame index
-     * \param lTime The time elapsed since the last update
+     * \param elapsed Seconds spent on the current frame. The length of the frame is taken off when it advances
      * \return The index of the new animation frame that should be rendered
      */
-    unsigned int incFrame(unsigned int cFrm, unsigned long lTime);
+    unsigned int incFrame(unsigned int cFrm, float& elapsed);
 
     /**
      * Tells the total number of frames in the loaded animation
@@ -108,7 +97,8 @@ public:
 
 private:
     TextureReference sheet;
-    std::vector<std::vector<AnimationFrame> > frames;
+    std::vector<AnimationFormat::Frame> frames;
+    std::vector<AnimationFormat::Piece> pieces;
     bool loop;
     std::vector<sf::Sprite> sprites;
     std::string spriteSheetFile;
@@ -146,9 +136,11 @@ public:
     void setSource(AnimationReference src, bool centerOrigin);
 
     /**
-     * Updates the animation. Sets the proper frame based on elapsed time since the last call to update
+     * Advances the animation by the given time. Long steps may pass several frames
+     *
+     * \param dt Seconds of simulation since the last update
      */
-    void update() const;
+    void update(float dt) const;
 
     /**
      * Sets the current frame to the given frame and resets the internal timer
@@ -222,11 +214,11 @@ public:
 	sf::Vector2f getSize() const;
 
     /**
-     * Renders the animation to the given window
+     * Renders the animation to the given target
      *
-     * \param window A pointer to the window to render to
+     * \param window The target to render to
      */
-    void draw(sf::RenderTarget& window) const;
+    void draw(CountingRenderTarget& window) const;
 
 private:
     AnimationReference animSrc;
@@ -234,7 +226,8 @@ private:
     float rotation;
     bool looping, isCenterOrigin;
 
-    mutable unsigned int curFrm, lastFrmChangeTime;
+    mutable unsigned int curFrm;
+    mutable float frameTime;
     mutable bool playing;
 };
 
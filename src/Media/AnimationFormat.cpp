@@ -0,0 +1,192 @@
+#include <Media/AnimationFormat.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace {
+/**
+ * Helper to read the little endian fields of v1 files out of a memory buffer
+ */
+class BufferReader {
+public:
+    BufferReader(const char* data, std::size_t size) : data(data), size(size), pos(0) {}
+
+    bool good() const { return pos <= size; }
+
+    template<typename T>
+    T get() {
+        T v = 0;
+        if (pos + sizeof(T) > size) {
+            pos = size + 1;
+            return v;
+        }
+        for (unsigned int i = 0; i < sizeof(T); ++i)
+            v |= static_cast<T>(static_cast<uint8_t>(data[pos + i])) << (i * 8);
+        pos += sizeof(T);
+        return v;
+    }
+
+    std::string getString() {
+        const uint32_t len = get<uint32_t>();
+        if (!good() || pos + len > size) {
+            pos = size + 1;
+            return "";
+        }
+        std::string ret(data + pos, len);
+        pos += len;
+        return ret;
+    }
+
+private:
+    const char* data;
+    const std::size_t size;
+    std::size_t pos;
+};
+
+std::size_t paddedLength(std::size_t len) {
+    return (len + 3) & ~static_cast<std::size_t>(3);
+}
+}
+
+bool AnimationFormat::load(const std::string& file, Data& data, int* version) {
+    std::ifstream input(file.c_str(), std::ios::in | std::ios::binary);
+    if (!input.good()) {
+        std::cerr << "Failed to open animation: " << file << std::endl;
+        return false;
+    }
+
+    input.seekg(0, std::ios::end);
+    const std::streamoff size = input.tellg();
+    input.seekg(0, std::ios::beg);
+    if (size <= 0) {
+        std::cerr << "Animation file is empty: " << file << std::endl;
+        return false;
+    }
+
+    std::vector<char> buffer(static_cast<std::size_t>(size));
+    input.read(buffer.data(), size);
+    if (!input.good()) {
+        std::cerr << "Failed to read animation: " << file << std::endl;
+        return false;
+    }
+
+    if (!parse(buffer.data(), buffer.size(), data, version)) {
+        std::cerr << "Animation file is corrupt: " << file << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool AnimationFormat::parse(const char* buffer, std::size_t size, Data& data, int* version) {
+    data = Data();
+    if (size >= sizeof(Magic) && std::memcmp(buffer, Magic, sizeof(Magic)) == 0) {
+        if (version)
+            *version = CurrentVersion;
+        return parseV2(buffer, size, data);
+    }
+    if (version)
+        *version = 1;
+    return parseV1(buffer, size, data);
+}
+
+bool AnimationFormat::parseV1(const char* buffer, std::size_t size, Data& data) {
+    BufferReader input(buffer, size);
+
+    data.spritesheet = input.getString();
+    data.loop = input.get<uint8_t>() != 0;
+    const uint16_t numFrames = input.get<uint16_t>();
+    data.frames.resize(numFrames);
+    for (unsigned int i = 0; i < numFrames && input.good(); ++i) {
+        Frame& frame = data.frames[i];
+        frame.length = input.get<uint32_t>();
+        frame.firstPiece = data.pieces.size();
+        frame.pieceCount = input.get<uint16_t>();
+        for (unsigned int j = 0; j < frame.pieceCount; ++j) {
+            Piece piece;
+            piece.sourceX = input.get<uint32_t>();
+            piece.sourceY = input.get<uint32_t>();
+            piece.width = input.get<uint32_t>();
+            piece.height = input.get<uint32_t>();
+            piece.scaleX = static_cast<float>(input.get<uint32_t>()) / 100.0f;
+            piece.scaleY = static_cast<float>(input.get<uint32_t>()) / 100.0f;
+            piece.offsetX = input.get<int32_t>();
+            piece.offsetY = input.get<int32_t>();
+            piece.rotation = static_cast<float>(input.get<int32_t>());
+            piece.alpha = input.get<uint8_t>();
+            std::memset(piece.padding, 0, sizeof(piece.padding));
+            data.pieces.push_back(piece);
+        }
+    }
+
+    return input.good();
+}
+
+bool AnimationFormat::parseV2(const char* buffer, std::size_t size, Data& data) {
+    if (size < sizeof(Header))
+        return false;
+
+    Header header;
+    std::memcpy(&header, buffer, sizeof(Header));
+    if (header.version != CurrentVersion) {
+        std::cerr << "Unsupported animation version: " << header.version << std::endl;
+        return false;
+    }
+
+    const std::size_t nameOffset = sizeof(Header);
+    const std::size_t frameOffset = nameOffset + paddedLength(header.spritesheetLength);
+    const std::size_t pieceOffset = frameOffset + header.frameCount * sizeof(Frame);
+    const std::size_t endOffset = pieceOffset + header.pieceCount * sizeof(Piece);
+    if (endOffset > size)
+        return false;
+
+    data.loop = header.loop != 0;
+    data.spritesheet.assign(buffer + nameOffset, header.spritesheetLength);
+    data.frames.resize(header.frameCount);
+    data.pieces.resize(header.pieceCount);
+    if (header.frameCount > 0)
+        std::memcpy(data.frames.data(), buffer + frameOffset, header.frameCount * sizeof(Frame));
+    if (header.pieceCount > 0)
+        std::memcpy(data.pieces.data(), buffer + pieceOffset, header.pieceCount * sizeof(Piece));
+
+    for (const Frame& frame : data.frames) {
+        // Written so that a crafted frame can not wrap around the piece count
+        if (frame.firstPiece > header.pieceCount || frame.pieceCount > header.pieceCount - frame.firstPiece)
+            return false;
+    }
+    return true;
+}
+
+bool AnimationFormat::save(const std::string& file, const Data& data) {
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = CurrentVersion;
+    header.loop = data.loop ? 1 : 0;
+    header.reserved = 0;
+    header.frameCount = data.frames.size();
+    header.pieceCount = data.pieces.size();
+    header.spritesheetLength = data.spritesheet.size();
+
+    const std::size_t nameLength = paddedLength(data.spritesheet.size());
+    std::vector<char> buffer(
+        sizeof(Header) + nameLength + data.frames.size() * sizeof(Frame) + data.pieces.size() * sizeof(Piece), 0
+    );
+    char* out = buffer.data();
+    std::memcpy(out, &header, sizeof(Header));
+    out += sizeof(Header);
+    std::memcpy(out, data.spritesheet.data(), data.spritesheet.size());
+    out += nameLength;
+    if (!data.frames.empty())
+        std::memcpy(out, data.frames.data(), data.frames.size() * sizeof(Frame));
+    out += data.frames.size() * sizeof(Frame);
+    if (!data.pieces.empty())
+        std::memcpy(out, data.pieces.data(), data.pieces.size() * sizeof(Piece));
+
+    std::ofstream output(file.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    output.write(buffer.data(), buffer.size());
+    if (!output.good()) {
+        std::cerr << "Failed to write animation: " << file << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,115 @@
+#ifndef ANIMATIONFORMAT_HPP
+#define ANIMATIONFORMAT_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Describes the on-disk layout of .anim files and handles reading and writing them. Two versions
+ * are supported:
+ *
+ *  - v1: Legacy format where every field is an individually serialized integer. Scale is stored
+ *        as an integer percent and there is no header or frame index
+ *  - v2: Header, frame table and packed piece table. The whole file is read with a single call and
+ *        the tables are copied directly into memory. Data is little endian
+ *
+ * The v2 layout is:
+ *
+ *      Header | spritesheet name (padded to 4 bytes) | Frame[frameCount] | Piece[pieceCount]
+ *
+ * \ingroup Media
+ */
+struct AnimationFormat {
+    static constexpr char Magic[4] = {'S', 'R', 'A', 'N'};
+    static constexpr uint16_t CurrentVersion = 2;
+
+#pragma pack(push, 1)
+    /**
+     * Leading block of a v2 file
+     */
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint8_t loop;
+        uint8_t reserved;
+        uint32_t frameCount;
+        uint32_t pieceCount;
+        uint32_t spritesheetLength;
+    };
+
+    /**
+     * Entry in the frame table. Pieces of a frame are contiguous in the piece table
+     */
+    struct Frame {
+        uint32_t length;
+        uint32_t firstPiece;
+        uint32_t pieceCount;
+    };
+
+    /**
+     * Single sprite piece of a frame
+     */
+    struct Piece {
+        int32_t sourceX, sourceY;
+        int32_t width, height;
+        float scaleX, scaleY;
+        int32_t offsetX, offsetY;
+        float rotation;
+        uint8_t alpha;
+        uint8_t padding[3];
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(Header) == 20, "Animation header must be packed");
+    static_assert(sizeof(Frame) == 12, "Animation frame must be packed");
+    static_assert(sizeof(Piece) == 40, "Animation piece must be packed");
+
+    /**
+     * In-memory representation of an animation file, independent of the version it was loaded from
+     */
+    struct Data {
+        std::string spritesheet;
+        bool loop;
+        std::vector<Frame> frames;
+        std::vector<Piece> pieces;
+
+        Data() : loop(true) {}
+    };
+
+    /**
+     * Loads the given file, detecting the version from the header
+     *
+     * \param file The path of the file to load
+     * \param data The object to populate
+     * \param version Optional output for the version that was detected
+     * \return True on success, false on error
+     */
+    static bool load(const std::string& file, Data& data, int* version = nullptr);
+
+    /**
+     * Parses an animation from a buffer already in memory. Detects the version
+     *
+     * \param buffer Pointer to the file contents
+     * \param size Size of the buffer in bytes
+     * \param data The object to populate
+     * \param version Optional output for the version that was detected
+     * \return True on success, false on error
+     */
+    static bool parse(const char* buffer, std::size_t size, Data& data, int* version = nullptr);
+
+    /**
+     * Writes the animation to the given file in the v2 format
+     *
+     * \param file The path of the file to write
+     * \param data The animation to save
+     * \return True on success, false on error
+     */
+    static bool save(const std::string& file, const Data& data);
+
+private:
+    static bool parseV1(const char* buffer, std::size_t size, Data& data);
+    static bool parseV2(const char* buffer, std::size_t size, Data& data);
+};
+
+#endif
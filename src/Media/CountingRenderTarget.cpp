@@ -0,0 +1,101 @@
+#include <Media/CountingRenderTarget.hpp>
+
+CountingRenderTarget::CountingRenderTarget(sf::RenderTarget& target)
+: target(target)
+, lastTexture(nullptr)
+, lastShader(nullptr)
+, lastBlendMode(sf::BlendAlpha) {}
+
+void CountingRenderTarget::clear(const sf::Color& color) {
+    target.clear(color);
+}
+
+void CountingRenderTarget::setView(const sf::View& view) {
+    target.setView(view);
+}
+
+const sf::View& CountingRenderTarget::getView() const {
+    return target.getView();
+}
+
+const sf::View& CountingRenderTarget::getDefaultView() const {
+    return target.getDefaultView();
+}
+
+sf::Vector2u CountingRenderTarget::getSize() const {
+    return target.getSize();
+}
+
+void CountingRenderTarget::draw(const sf::Sprite& sprite, const sf::RenderStates& states) {
+    count(1, 4, sprite.getTexture(), states);
+    target.draw(sprite, states);
+}
+
+void CountingRenderTarget::draw(const sf::Shape& shape, const sf::RenderStates& states) {
+    // Fill is a fan around the center, outline is a strip around the edge
+    const std::size_t points = shape.getPointCount();
+    if (shape.getOutlineThickness() != 0)
+        count(2, points + 2 + (points + 1) * 2, shape.getTexture(), states);
+    else
+        count(1, points + 2, shape.getTexture(), states);
+    target.draw(shape, states);
+}
+
+void CountingRenderTarget::draw(const sf::Text& text, const sf::RenderStates& states) {
+    const sf::Texture* texture = nullptr;
+    if (text.getFont())
+        texture = &text.getFont()->getTexture(text.getCharacterSize());
+
+    // Six vertices per glyph, doubled when the outline is drawn
+    const std::size_t glyphVertices = text.getString().getSize() * 6;
+    if (text.getOutlineThickness() != 0)
+        count(2, glyphVertices * 2, texture, states);
+    else
+        count(1, glyphVertices, texture, states);
+    target.draw(text, states);
+}
+
+void CountingRenderTarget::draw(const sf::VertexArray& vertices, const sf::RenderStates& states) {
+    count(1, vertices.getVertexCount(), states.texture, states);
+    target.draw(vertices, states);
+}
+
+void CountingRenderTarget::draw(const sf::Drawable& drawable, const sf::RenderStates& states) {
+    count(1, 0, states.texture, states);
+    target.draw(drawable, states);
+}
+
+void CountingRenderTarget::draw(const sf::Vertex* vertices, std::size_t n, sf::PrimitiveType type,
+                                const sf::RenderStates& states) {
+    count(1, n, states.texture, states);
+    target.draw(vertices, n, type, states);
+}
+
+const CountingRenderTarget::Stats& CountingRenderTarget::getStats() const {
+    return stats;
+}
+
+CountingRenderTarget::Stats CountingRenderTarget::endFrame() {
+    const Stats frame = stats;
+    stats = Stats();
+    return frame;
+}
+
+sf::RenderTarget& CountingRenderTarget::getTarget() {
+    return target;
+}
+
+void CountingRenderTarget::count(unsigned int calls, std::size_t vertices, const sf::Texture* texture,
+                                 const sf::RenderStates& states) {
+    stats.drawCalls += calls;
+    stats.vertices += vertices;
+    if (texture != lastTexture) {
+        stats.textureSwitches += 1;
+        lastTexture = texture;
+    }
+    if (states.shader != lastShader || states.blendMode != lastBlendMode) {
+        stats.stateChanges += 1;
+        lastShader = states.shader;
+        lastBlendMode = states.blendMode;
+    }
+}
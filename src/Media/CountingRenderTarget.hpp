@@ -0,0 +1,66 @@
+#ifndef COUNTINGRENDERTARGET_HPP
+#define COUNTINGRENDERTARGET_HPP
+
+#include <SFML/Graphics.hpp>
+
+/**
+ * Wrapper over sf::RenderTarget that counts what is drawn through it. Tracks draw calls, vertices,
+ * texture switches and changes of blend mode or shader. Counts accumulate until endFrame()
+ *
+ * Vertex counts are exact for sprites, vertex arrays and raw vertices, and computed from the point
+ * or glyph count for shapes and text. Other drawables count as a single call with no vertices
+ */
+class CountingRenderTarget {
+public:
+    struct Stats {
+        unsigned int drawCalls = 0;
+        unsigned int vertices = 0;
+        unsigned int textureSwitches = 0;
+        unsigned int stateChanges = 0;
+    };
+
+    /**
+     * Wraps the given target. The target must outlive the wrapper
+     */
+    explicit CountingRenderTarget(sf::RenderTarget& target);
+
+    void clear(const sf::Color& color = sf::Color::Black);
+    void setView(const sf::View& view);
+    const sf::View& getView() const;
+    const sf::View& getDefaultView() const;
+    sf::Vector2u getSize() const;
+
+    void draw(const sf::Sprite& sprite, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Shape& shape, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Text& text, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::VertexArray& vertices, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Drawable& drawable, const sf::RenderStates& states = sf::RenderStates::Default);
+    void draw(const sf::Vertex* vertices, std::size_t count, sf::PrimitiveType type,
+              const sf::RenderStates& states = sf::RenderStates::Default);
+
+    /**
+     * Returns the counts since the last call to endFrame()
+     */
+    const Stats& getStats() const;
+
+    /**
+     * Returns the counts for the frame and starts counting the next one
+     */
+    Stats endFrame();
+
+    /**
+     * Returns the wrapped target. Drawing to it directly is not counted
+     */
+    sf::RenderTarget& getTarget();
+
+private:
+    sf::RenderTarget& target;
+    Stats stats;
+    const sf::Texture* lastTexture;
+    const sf::Shader* lastShader;
+    sf::BlendMode lastBlendMode;
+
+    void count(unsigned int calls, std::size_t vertices, const sf::Texture* texture, const sf::RenderStates& states);
+};
+
+#endif
\ No newline at end of file
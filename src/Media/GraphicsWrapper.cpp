@@ -108,7 +108,13 @@ sf::Vector2f GraphicsWrapper::getSize() const {
     }
 }
 
-void GraphicsWrapper::render(sf::RenderTarget& target) const {
+void GraphicsWrapper::update(float dt) {
+    const Animation* anim = std::get_if<Animation>(&gfx);
+    if (anim)
+        anim->update(dt);
+}
+
+void GraphicsWrapper::render(CountingRenderTarget& target) const {
     const sf::Sprite* spr = std::get_if<sf::Sprite>(&gfx);
     if (spr)
         target.draw(*spr);
@@ -23,7 +23,14 @@ public:
 
     sf::Vector2f getSize() const;
 
-    void render(sf::RenderTarget& target) const;
+    /**
+     * Advances the animation, if this wraps one
+     *
+     * \param dt Seconds of simulation since the last update
+     */
+    void update(float dt);
+
+    void render(CountingRenderTarget& target) const;
 
 private:
     typedef std::variant<TextureReference, AnimationReference> TSrc;
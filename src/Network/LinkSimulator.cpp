@@ -0,0 +1,38 @@
+#include <Network/LinkSimulator.hpp>
+
+LinkSimulator::LinkSimulator(const Conditions& conditions, std::uint64_t seed)
+: conditions(conditions)
+, random(seed) {}
+
+bool LinkSimulator::isEnabled() const {
+    return conditions.latency > sf::Time::Zero || conditions.jitter > sf::Time::Zero || conditions.loss > 0 ||
+           conditions.outage > sf::Time::Zero;
+}
+
+void LinkSimulator::send(const sf::Packet& packet, const sf::IpAddress& address, unsigned short port) {
+    const sf::Time now = clock.getElapsedTime();
+    if (random.nextFloat() < conditions.loss ||
+        (now >= conditions.outageStart && now < conditions.outageStart + conditions.outage))
+        return;
+
+    const float jitter = random.nextFloat() * conditions.jitter.asSeconds();
+    Pending entry;
+    entry.due = now + conditions.latency + sf::seconds(jitter);
+    const char* data = static_cast<const char*>(packet.getData());
+    entry.data.assign(data, data + packet.getDataSize());
+    entry.address = address;
+    entry.port = port;
+    pending.push_back(entry);
+}
+
+void LinkSimulator::flush(sf::UdpSocket& socket) {
+    const sf::Time now = clock.getElapsedTime();
+    for (auto i = pending.begin(); i != pending.end();) {
+        if (i->due <= now) {
+            socket.send(i->data.data(), i->data.size(), i->address, i->port);
+            i = pending.erase(i);
+        }
+        else
+            ++i;
+    }
+}
\ No newline at end of file
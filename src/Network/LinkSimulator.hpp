@@ -0,0 +1,63 @@
+#ifndef LINKSIMULATOR_HPP
+#define LINKSIMULATOR_HPP
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include <SFML/Network.hpp>
+#include <Util/Random.hpp>
+
+/**
+ * Simulates a poor network on outgoing packets for testing netcode on loopback. Packets are held
+ * back by the latency plus a random jitter, and a fraction of them are dropped. Jitter can reorder
+ * packets, as on a real network. An outage drops every packet for a while, like a dropped
+ * connection that comes back
+ */
+class LinkSimulator {
+public:
+    struct Conditions {
+        sf::Time latency;
+        sf::Time jitter;
+        float loss = 0; // fraction of packets dropped, in [0, 1]
+        sf::Time outageStart; // time after creation that the outage begins
+        sf::Time outage; // length of the outage, none if zero
+    };
+
+    /**
+     * Creates the simulator
+     *
+     * \param conditions The network conditions to simulate
+     * \param seed Seed for the jitter and losses. Separate from the simulation's random numbers
+     */
+    LinkSimulator(const Conditions& conditions, std::uint64_t seed);
+
+    /**
+     * Returns true if any latency or loss is simulated
+     */
+    bool isEnabled() const;
+
+    /**
+     * Queues the packet, or drops it
+     */
+    void send(const sf::Packet& packet, const sf::IpAddress& address, unsigned short port);
+
+    /**
+     * Sends the queued packets that are due
+     */
+    void flush(sf::UdpSocket& socket);
+
+private:
+    struct Pending {
+        sf::Time due;
+        std::vector<char> data;
+        sf::IpAddress address;
+        unsigned short port;
+    };
+
+    const Conditions conditions;
+    Random random;
+    sf::Clock clock;
+    std::deque<Pending> pending;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include <Network/LockstepController.hpp>
+
+#include <Entities/Controllers/PlayerController.hpp>
+#include <Environment/Environment.hpp>
+
+EntityController::Ptr LockstepController::create(LockstepSession::Ptr session, unsigned int player) {
+    return EntityController::Ptr(new LockstepController(session, player));
+}
+
+LockstepController::LockstepController(LockstepSession::Ptr session, unsigned int player)
+: session(session)
+, player(player) {}
+
+void LockstepController::setupPlayers(Environment& environment, LockstepSession::Ptr session) {
+    environment.setPlayerController(create(session, 0));
+    for (unsigned int i = 1; i < session->getConfig().playerCount; ++i)
+        environment.addPlayer(create(session, i));
+    environment.setLocalPlayer(session->getConfig().playerId);
+}
+
+void LockstepController::update(Entity* entity, float) {
+    PlayerController::applyInput(entity, session->getInput(player));
+}
\ No newline at end of file
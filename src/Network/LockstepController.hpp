@@ -0,0 +1,34 @@
+#ifndef LOCKSTEPCONTROLLER_HPP
+#define LOCKSTEPCONTROLLER_HPP
+
+#include <Entities/EntityController.hpp>
+#include <Network/LockstepSession.hpp>
+
+class Environment;
+
+/**
+ * EntityController that applies a player's input from a LockstepSession. Every player is driven
+ * this way, including the local one, so that all machines apply the same input on the same tick
+ */
+class LockstepController : public EntityController {
+public:
+    virtual ~LockstepController() = default;
+
+    static EntityController::Ptr create(LockstepSession::Ptr session, unsigned int player);
+
+    /**
+     * Adds the players of the session to the environment, in player order, and makes this machine's
+     * player the local one
+     */
+    static void setupPlayers(Environment& environment, LockstepSession::Ptr session);
+
+    virtual void update(Entity* entity, float dt) override;
+
+private:
+    LockstepSession::Ptr session;
+    const unsigned int player;
+
+    LockstepController(LockstepSession::Ptr session, unsigned int player);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <Network/LockstepRunner.hpp>
+
+#include <iostream>
+#include <Environment/Environment.hpp>
+#include <Properties.hpp>
+#include <Util/Profiler.hpp>
+
+LockstepRunner::LockstepRunner(Environment& environment, LockstepSession::Ptr session, unsigned int resimulationBudget)
+: environment(environment)
+, session(session)
+, budget(resimulationBudget)
+, history(LockstepSession::historyLength())
+, present(0)
+, failed(false) {
+    environment.saveState(history[0]);
+}
+
+LockstepRunner::Stats LockstepRunner::update(unsigned int ticks, const std::function<InputFrame()>& input) {
+    Stats stats;
+    session->poll();
+    if (failed)
+        return stats;
+
+    const std::uint32_t rollbackTick = session->getRollbackTick();
+    if (rollbackTick != LockstepSession::NoRollback) {
+        if (rollbackTick < session->getTick()) {
+            PROFILE_ZONE("Rollback restore");
+            if (!environment.loadState(history[rollbackTick % history.size()])) {
+                std::cerr << "Failed to roll back to tick " << rollbackTick << std::endl;
+                failed = true;
+                return stats;
+            }
+            stats.rollbacks = 1;
+        }
+        session->rollback(rollbackTick);
+    }
+
+    // Back to the present before anything new
+    while (session->getTick() < present && stats.resimulated < budget) {
+        simulate();
+        stats.resimulated += 1;
+    }
+    if (session->getTick() < present)
+        return stats;
+
+    for (unsigned int i = 0; i < ticks; ++i) {
+        if (session->needsLocalInput())
+            session->setLocalInput(input());
+        if (!session->canAdvance()) {
+            stats.waiting = true;
+            break;
+        }
+        simulate();
+        stats.simulated += 1;
+    }
+    present = session->getTick();
+    return stats;
+}
+
+std::uint32_t LockstepRunner::getPresentTick() const {
+    return present;
+}
+
+const Snapshot& LockstepRunner::getState(std::uint32_t tick) const {
+    return history[tick % history.size()];
+}
+
+bool LockstepRunner::hasFailed() const {
+    return failed;
+}
+
+void LockstepRunner::simulate() {
+    environment.update(Properties::FixedTickLength);
+    Snapshot& state = history[(session->getTick() + 1) % history.size()];
+    environment.saveState(state);
+    session->advance(state.checksum());
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef LOCKSTEPRUNNER_HPP
+#define LOCKSTEPRUNNER_HPP
+
+#include <functional>
+#include <vector>
+#include <Environment/Snapshot.hpp>
+#include <Network/LockstepSession.hpp>
+
+class Environment;
+
+/**
+ * Steps an Environment in a networked race. The state before every tick that may still be rolled
+ * back is kept as a Snapshot. When the session reports a misprediction the state before that tick
+ * is restored and the ticks up to the present are simulated again
+ *
+ * Simulating back to the present is limited to a budget of ticks per update so that a long
+ * rollback does not stall a frame. New ticks wait until the present is reached again
+ */
+class LockstepRunner {
+public:
+    /**
+     * What an update did
+     */
+    struct Stats {
+        unsigned int simulated = 0;
+        unsigned int resimulated = 0;
+        unsigned int rollbacks = 0;
+        bool waiting = false; // stopped for input from other players
+    };
+
+    /**
+     * Creates the runner. The players should already be set up, see LockstepController
+     *
+     * \param environment The environment to step
+     * \param session The session providing input
+     * \param resimulationBudget Most ticks simulated again per update
+     */
+    LockstepRunner(Environment& environment, LockstepSession::Ptr session, unsigned int resimulationBudget);
+
+    /**
+     * Polls the session, handles any rollback and simulates up to the given number of new ticks
+     *
+     * \param ticks The number of new ticks due
+     * \param input Returns the local input for the next new tick
+     * \return What was simulated
+     */
+    Stats update(unsigned int ticks, const std::function<InputFrame()>& input);
+
+    /**
+     * Returns the number of ticks simulated, not counting ticks simulated again
+     */
+    std::uint32_t getPresentTick() const;
+
+    /**
+     * Returns the state before the given tick. Only ticks within the session history are kept
+     */
+    const Snapshot& getState(std::uint32_t tick) const;
+
+    /**
+     * Returns true if a rollback could not be restored. The race can not continue
+     */
+    bool hasFailed() const;
+
+private:
+    Environment& environment;
+    LockstepSession::Ptr session;
+    const unsigned int budget;
+    std::vector<Snapshot> history; // state before each tick, [tick % history length]
+    std::uint32_t present;
+    bool failed;
+
+    void simulate();
+};
+
+#endif
\ No newline at end of file
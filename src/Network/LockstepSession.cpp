@@ -0,0 +1,257 @@
+#include <Network/LockstepSession.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <Util/Util.hpp>
+
+namespace {
+const sf::Uint32 ProtocolId = 0x53524c33; // SRL3
+const sf::Time ResendInterval = sf::milliseconds(15);
+const std::uint64_t LinkStream = 2000;
+}
+
+LockstepSession::LockstepSession(const Config& cfg)
+: config(cfg)
+, link(cfg.network, Random(cfg.seed, LinkStream + cfg.playerId).next())
+, tick(0)
+, rollbackTick(NoRollback)
+, desynced(false)
+, desyncTick(0) {
+    // Input can not be scheduled or predicted past the history
+    config.inputDelay = std::max(1u, std::min(config.inputDelay, Window / 4));
+    config.maxPrediction = std::min(config.maxPrediction, Window / 4);
+    nextLocalTick = config.inputDelay;
+
+    // Nobody has input for the ticks before the delay
+    inputs.resize(config.playerCount, std::vector<TickInput>(Window, {0, false, InputFrame()}));
+    used.resize(config.playerCount, std::vector<TickInput>(Window, {0, false, InputFrame()}));
+    hashes.resize(config.playerCount, std::vector<TickHash>(Window, {0, false, 0}));
+    confirmed.resize(config.playerCount, config.inputDelay);
+    acked.resize(config.playerCount, config.inputDelay);
+    remoteHashTicks.resize(config.playerCount, 0);
+    for (std::vector<TickInput>& playerInputs : inputs) {
+        for (std::uint32_t t = 0; t < config.inputDelay; ++t)
+            playerInputs[t] = {t, true, InputFrame()};
+    }
+}
+
+LockstepSession::Ptr LockstepSession::create(const Config& config) {
+    if (config.playerId >= config.playerCount || config.playerCount > 255) {
+        std::cerr << "Invalid player " << config.playerId << " of " << config.playerCount << std::endl;
+        return nullptr;
+    }
+
+    Ptr session(new LockstepSession(config));
+    if (session->socket.bind(config.port) != sf::Socket::Done) {
+        std::cerr << "Failed to bind UDP port " << config.port << std::endl;
+        return nullptr;
+    }
+    session->socket.setBlocking(false);
+    return session;
+}
+
+bool LockstepSession::parsePeer(const std::string& str, Peer& peer) {
+    const std::size_t colon = str.rfind(':');
+    if (colon == std::string::npos || colon == 0 || colon + 1 == str.size()) {
+        std::cerr << "Peers are given as host:port, got " << str << std::endl;
+        return false;
+    }
+    peer.address = sf::IpAddress(str.substr(0, colon));
+    const int port = stringToInt(str.substr(colon + 1));
+    if (peer.address == sf::IpAddress::None || port <= 0 || port > 65535) {
+        std::cerr << "Invalid peer " << str << std::endl;
+        return false;
+    }
+    peer.port = port;
+    return true;
+}
+
+unsigned int LockstepSession::historyLength() {
+    return Window;
+}
+
+void LockstepSession::poll() {
+    sf::Packet packet;
+    sf::IpAddress sender;
+    unsigned short port;
+    while (socket.receive(packet, sender, port) == sf::Socket::Done)
+        receive(packet);
+
+    // Hashes that arrived before the local tick was confirmed
+    for (unsigned int player = 0; player < config.playerCount; ++player)
+        compareHashes(remoteHashTicks[player]);
+
+    if (resendTimer.getElapsedTime() >= ResendInterval)
+        send();
+    link.flush(socket);
+}
+
+bool LockstepSession::needsLocalInput() const {
+    return nextLocalTick <= tick + config.inputDelay;
+}
+
+void LockstepSession::setLocalInput(const InputFrame& input) {
+    inputs[config.playerId][nextLocalTick % Window] = {nextLocalTick, true, input};
+    ++nextLocalTick;
+    confirmed[config.playerId] = nextLocalTick;
+    send();
+}
+
+bool LockstepSession::canAdvance() const {
+    return tick < getConfirmedTick() + config.maxPrediction;
+}
+
+const InputFrame& LockstepSession::getInput(unsigned int player) const {
+    const TickInput& slot = inputs[player][tick % Window];
+    if (slot.known && slot.tick == tick)
+        return slot.input;
+
+    // Predict that the player is still holding what they last held
+    const std::uint32_t last = confirmed[player] - 1;
+    return inputs[player][last % Window].input;
+}
+
+void LockstepSession::advance(std::uint32_t stateHash) {
+    for (unsigned int player = 0; player < config.playerCount; ++player)
+        used[player][tick % Window] = {tick, true, getInput(player)};
+    hashes[config.playerId][tick % Window] = {tick, true, stateHash};
+    ++tick;
+    compareHashes(tick - 1);
+}
+
+std::uint32_t LockstepSession::getRollbackTick() const {
+    return rollbackTick;
+}
+
+void LockstepSession::rollback(std::uint32_t t) {
+    tick = std::min(tick, t);
+    if (rollbackTick >= tick)
+        rollbackTick = NoRollback;
+}
+
+std::uint32_t LockstepSession::getTick() const {
+    return tick;
+}
+
+std::uint32_t LockstepSession::getConfirmedTick() const {
+    return *std::min_element(confirmed.begin(), confirmed.end());
+}
+
+const LockstepSession::Config& LockstepSession::getConfig() const {
+    return config;
+}
+
+bool LockstepSession::hasDesynced() const {
+    return desynced;
+}
+
+std::uint32_t LockstepSession::getDesyncTick() const {
+    return desyncTick;
+}
+
+std::uint32_t LockstepSession::verifiedTick() const {
+    // Ticks are final once simulated with confirmed input and no rollback is pending over them
+    return std::min(std::min(tick, getConfirmedTick()), rollbackTick);
+}
+
+void LockstepSession::send() {
+    // Local input from the oldest tick a peer is missing, what was received from everyone and the
+    // hash of the latest final tick. Peers can not fall a whole window behind, since they would
+    // have stopped to wait for this input, but the history is the limit either way
+    std::uint32_t first = nextLocalTick > Window ? nextLocalTick - Window : 0;
+    std::uint32_t missing = nextLocalTick;
+    for (unsigned int player = 0; player < config.playerCount; ++player) {
+        if (player != config.playerId)
+            missing = std::min(missing, acked[player]);
+    }
+    first = std::max(first, missing);
+
+    sf::Packet packet;
+    packet << ProtocolId << sf::Uint8(config.playerId) << sf::Uint32(first)
+           << sf::Uint16(nextLocalTick - first);
+    for (std::uint32_t t = first; t < nextLocalTick; ++t)
+        packet << sf::Uint8(inputs[config.playerId][t % Window].input.buttons);
+    for (unsigned int player = 0; player < config.playerCount; ++player)
+        packet << sf::Uint32(confirmed[player]);
+
+    const std::uint32_t verified = verifiedTick();
+    const bool hasHash = verified > 0;
+    packet << hasHash;
+    if (hasHash) {
+        const TickHash& hash = hashes[config.playerId][(verified - 1) % Window];
+        packet << sf::Uint32(hash.tick) << sf::Uint32(hash.hash);
+    }
+
+    for (const Peer& peer : config.peers) {
+        if (link.isEnabled())
+            link.send(packet, peer.address, peer.port);
+        else
+            socket.send(packet, peer.address, peer.port);
+    }
+    resendTimer.restart();
+}
+
+void LockstepSession::receive(sf::Packet& packet) {
+    sf::Uint32 protocol, first;
+    sf::Uint8 player;
+    sf::Uint16 count;
+    if (!(packet >> protocol >> player >> first >> count) || protocol != ProtocolId ||
+        player >= config.playerCount || player == config.playerId)
+        return;
+
+    std::vector<TickInput>& playerInputs = inputs[player];
+    const std::uint32_t oldest = getConfirmedTick();
+    for (std::uint32_t t = first; t < first + count; ++t) {
+        InputFrame input;
+        if (!(packet >> input.buttons))
+            return;
+        // Inputs already confirmed or too far ahead to store are dropped
+        if (t < confirmed[player] || t + 1 >= oldest + Window)
+            continue;
+        TickInput& slot = playerInputs[t % Window];
+        if (slot.known && slot.tick == t)
+            continue;
+        slot = {t, true, input};
+
+        // Ticks already simulated with a different prediction have to be simulated again
+        const TickInput& guess = used[player][t % Window];
+        if (t < tick && guess.tick == t && guess.input.buttons != input.buttons)
+            rollbackTick = std::min(rollbackTick, t);
+    }
+    while (playerInputs[confirmed[player] % Window].known &&
+           playerInputs[confirmed[player] % Window].tick == confirmed[player])
+        ++confirmed[player];
+
+    // Packets may arrive out of order, so acknowledgements only move forward
+    for (unsigned int i = 0; i < config.playerCount; ++i) {
+        sf::Uint32 received;
+        if (!(packet >> received))
+            return;
+        if (i == config.playerId)
+            acked[player] = std::max(acked[player], std::uint32_t(received));
+    }
+
+    bool hasHash;
+    sf::Uint32 hashTick, hash;
+    if (packet >> hasHash && hasHash && packet >> hashTick >> hash) {
+        hashes[player][hashTick % Window] = {hashTick, true, hash};
+        remoteHashTicks[player] = std::max(remoteHashTicks[player], std::uint32_t(hashTick));
+        compareHashes(hashTick);
+    }
+}
+
+void LockstepSession::compareHashes(std::uint32_t hashTick) {
+    const TickHash& local = hashes[config.playerId][hashTick % Window];
+    if (desynced || hashTick >= verifiedTick() || !local.known || local.tick != hashTick)
+        return;
+
+    for (unsigned int player = 0; player < config.playerCount; ++player) {
+        const TickHash& remote = hashes[player][hashTick % Window];
+        if (remote.known && remote.tick == hashTick && remote.hash != local.hash) {
+            desynced = true;
+            desyncTick = hashTick;
+            std::cerr << "Desync with player " << player << " at tick " << hashTick << std::endl;
+            return;
+        }
+    }
+}
\ No newline at end of file
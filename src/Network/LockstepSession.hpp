@@ -0,0 +1,178 @@
+#ifndef LOCKSTEPSESSION_HPP
+#define LOCKSTEPSESSION_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <SFML/Network.hpp>
+#include <Entities/Controllers/InputFrame.hpp>
+#include <Network/LinkSimulator.hpp>
+
+/**
+ * Input synchronization for networked races over UDP. Every machine runs the same simulation at a
+ * fixed tick length and only player input is exchanged. Local input is scheduled a few ticks
+ * ahead, the input delay, to hide latency
+ *
+ * Without prediction this is plain lockstep: a tick is only simulated once every player's input
+ * for it has arrived. With prediction, ticks may run ahead of the confirmed input by up to the
+ * prediction limit, using each remote player's last known input. When an input arrives that
+ * differs from the one predicted, the tick it belongs to is reported by getRollbackTick() and the
+ * caller restores the state before it and simulates again, see LockstepRunner
+ *
+ * Packets acknowledge the input received from every player, and each packet repeats the local
+ * input from the oldest tick a peer has not acknowledged. A lost packet is covered by the next
+ * one however many are lost in a row. Packets also carry the hash of the last confirmed state,
+ * which is compared with the local hash for the same tick to detect desyncs
+ */
+class LockstepSession {
+public:
+    typedef std::shared_ptr<LockstepSession> Ptr;
+
+    static constexpr std::uint32_t NoRollback = 0xFFFFFFFF;
+
+    /**
+     * Address of another player
+     */
+    struct Peer {
+        sf::IpAddress address;
+        unsigned short port;
+    };
+
+    struct Config {
+        unsigned int playerId = 0;
+        unsigned int playerCount = 1;
+        unsigned short port = 0;
+        std::vector<Peer> peers;
+        unsigned int inputDelay = 8;
+        unsigned int maxPrediction = 0; // ticks simulated ahead of confirmed input, 0 for lockstep
+        std::uint64_t seed = 1; // must match on every machine
+        LinkSimulator::Conditions network; // simulated on outgoing packets
+    };
+
+    /**
+     * Creates a session and binds its socket. Returns null on error
+     */
+    static Ptr create(const Config& config);
+
+    /**
+     * Parses a peer given as host:port
+     */
+    static bool parsePeer(const std::string& str, Peer& peer);
+
+    /**
+     * Returns the number of ticks of history kept. Rollbacks never go further back than this
+     */
+    static unsigned int historyLength();
+
+    /**
+     * Receives pending packets and periodically resends local input. Call every frame, including
+     * while waiting on other players
+     */
+    void poll();
+
+    /**
+     * Returns true if local input for the next scheduled tick is needed. One input is taken per
+     * simulated tick
+     */
+    bool needsLocalInput() const;
+
+    /**
+     * Schedules local input for tick getTick() + inputDelay and sends it
+     */
+    void setLocalInput(const InputFrame& input);
+
+    /**
+     * Returns true if the current tick can be simulated. Without prediction every player's input
+     * for it must be known, otherwise it must be within the prediction limit
+     */
+    bool canAdvance() const;
+
+    /**
+     * Returns the input of a player for the current tick, predicted if it has not arrived
+     */
+    const InputFrame& getInput(unsigned int player) const;
+
+    /**
+     * Finishes the current tick
+     *
+     * \param stateHash Hash of the simulation state after the tick, see Snapshot::checksum()
+     */
+    void advance(std::uint32_t stateHash);
+
+    /**
+     * Returns the earliest simulated tick that used a wrong prediction, or NoRollback
+     */
+    std::uint32_t getRollbackTick() const;
+
+    /**
+     * Moves back to the given tick after the caller restored the state from before it. Ticks from
+     * there are simulated again with the corrected input
+     */
+    void rollback(std::uint32_t tick);
+
+    /**
+     * Returns the tick to be simulated next
+     */
+    std::uint32_t getTick() const;
+
+    /**
+     * Returns the first tick that some player's input is still missing for
+     */
+    std::uint32_t getConfirmedTick() const;
+
+    const Config& getConfig() const;
+
+    /**
+     * Returns true once a player reported a different state hash for the same tick. Simulations
+     * that desync stay desynced, so this is never cleared
+     */
+    bool hasDesynced() const;
+
+    /**
+     * Returns the first tick found to differ
+     */
+    std::uint32_t getDesyncTick() const;
+
+private:
+    static constexpr unsigned int Window = 256; // ticks of input and hashes kept per player
+
+    struct TickInput {
+        std::uint32_t tick;
+        bool known;
+        InputFrame input;
+    };
+
+    struct TickHash {
+        std::uint32_t tick;
+        bool known;
+        std::uint32_t hash;
+    };
+
+    Config config;
+    sf::UdpSocket socket;
+    LinkSimulator link;
+    sf::Clock resendTimer;
+
+    std::uint32_t tick;
+    std::uint32_t nextLocalTick;
+    std::uint32_t rollbackTick;
+    std::vector<std::vector<TickInput> > inputs; // [player][tick % Window]
+    std::vector<std::vector<TickInput> > used; // input each simulated tick used, [player][tick % Window]
+    std::vector<std::uint32_t> confirmed; // first tick with unknown input, per player
+    std::vector<std::uint32_t> acked; // first tick of local input each player has not received
+    std::vector<std::vector<TickHash> > hashes; // [player][tick % Window]
+    std::vector<std::uint32_t> remoteHashTicks; // latest hash received, per player
+
+    bool desynced;
+    std::uint32_t desyncTick;
+
+    LockstepSession(const Config& config);
+
+    void send();
+    void receive(sf::Packet& packet);
+    std::uint32_t verifiedTick() const;
+    void compareHashes(std::uint32_t hashTick);
+};
+
+#endif
\ No newline at end of file
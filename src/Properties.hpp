@@ -13,6 +13,7 @@ class Properties
 public:
     static constexpr float GravitationalConstant = 1500;
     static constexpr float StdToSFMLRotationOffset = 90;
+    static constexpr float FixedTickLength = 1.0f / 240; // recorded and networked games
 
     static const int ScreenWidth = 1920;
     static const int ScreenHeight = 1080;
@@ -2,8 +2,10 @@
 #define ANGULARVECTOR_HPP
 
 #include <cmath>
+#include <cstddef>
 #include <SFML/Graphics.hpp>
 #include <Properties.hpp>
+#include <Util/FastTrig.hpp>
 
 /**
  * Angular contemporary to sf::Vector2<T>
@@ -50,4 +52,95 @@ struct AngularVector {
 
 typedef AngularVector<float> AngularVectorF;
 
+/**
+ * AngularVector that keeps both its polar and cartesian forms. Each is derived from the other only
+ * when it changes, using the approximations in FastTrig. Rotation and scaling update the cartesian
+ * form directly and addition works on it without converting back and forth
+ */
+template<typename T>
+class CachedAngularVector {
+public:
+    CachedAngularVector() : polar(), cart(0, 0) {}
+    CachedAngularVector(T magnitude, T angle) : polar(magnitude, angle), cart(toCartesian(polar)) {}
+    CachedAngularVector(const AngularVector<T>& vector) : polar(vector), cart(toCartesian(vector)) {}
+    CachedAngularVector(const sf::Vector2<T>& cartesianVector) : polar(toPolar(cartesianVector)), cart(cartesianVector) {}
+
+    T magnitude() const { return polar.magnitude; }
+    T angle() const { return polar.angle; }
+    const AngularVector<T>& angular() const { return polar; }
+    const sf::Vector2<T>& cartesian() const { return cart; }
+
+    CachedAngularVector& rotate(T d) {
+        float fs, fc;
+        FastTrig::sinCos(d, fs, fc);
+        const T s = static_cast<T>(fs);
+        const T c = static_cast<T>(fc);
+        polar.angle += d;
+        cart = {cart.x * c - cart.y * s, cart.x * s + cart.y * c};
+        return *this;
+    }
+
+    void operator+=(const CachedAngularVector& v) { *this = CachedAngularVector(cart + v.cart); }
+    void operator-=(const CachedAngularVector& v) { *this = CachedAngularVector(cart - v.cart); }
+    void operator+=(const sf::Vector2<T>& v) { *this = CachedAngularVector(cart + v); }
+    void operator-=(const sf::Vector2<T>& v) { *this = CachedAngularVector(cart - v); }
+    void operator*=(T m) { polar.magnitude *= m; cart *= m; }
+    void operator/=(T m) { polar.magnitude /= m; cart /= m; }
+
+    CachedAngularVector operator+(const CachedAngularVector& v) const { return CachedAngularVector(cart + v.cart); }
+    CachedAngularVector operator+(const sf::Vector2<T>& v) const { return CachedAngularVector(cart + v); }
+
+    CachedAngularVector operator-(const CachedAngularVector& v) const { return CachedAngularVector(cart - v.cart); }
+    CachedAngularVector operator-(const sf::Vector2<T>& v) const { return CachedAngularVector(cart - v); }
+
+    CachedAngularVector operator*(T m) const { return CachedAngularVector(polar.magnitude * m, polar.angle, cart * m); }
+    CachedAngularVector operator/(T m) const { return CachedAngularVector(polar.magnitude / m, polar.angle, cart / m); }
+
+    /**
+     * Converts from polar form using the fast approximations
+     */
+    static sf::Vector2<T> toCartesian(const AngularVector<T>& vector) {
+        float s, c;
+        FastTrig::sinCos(vector.angle - Properties::StdToSFMLRotationOffset, s, c);
+        return {vector.magnitude * static_cast<T>(c), vector.magnitude * static_cast<T>(s)};
+    }
+
+    /**
+     * Converts to polar form using the fast approximations
+     */
+    static AngularVector<T> toPolar(const sf::Vector2<T>& vector) {
+        return AngularVector<T>(
+            std::sqrt(vector.x*vector.x + vector.y*vector.y),
+            FastTrig::atan2(vector.y, vector.x) + Properties::StdToSFMLRotationOffset
+        );
+    }
+
+private:
+    AngularVector<T> polar;
+    sf::Vector2<T> cart;
+
+    CachedAngularVector(T magnitude, T angle, const sf::Vector2<T>& cartesianVector)
+    : polar(magnitude, angle), cart(cartesianVector) {}
+};
+
+typedef CachedAngularVector<float> CachedAngularVectorF;
+
+/**
+ * Converts an array of angular vectors to cartesian form. The arrays may not overlap
+ */
+template<typename T>
+void toCartesian(const AngularVector<T>* input, sf::Vector2<T>* output, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = CachedAngularVector<T>::toCartesian(input[i]);
+}
+
+/**
+ * Converts an array of cartesian vectors to angular form. The arrays may not overlap
+ */
+template<typename T>
+void toAngular(const sf::Vector2<T>* input, AngularVector<T>* output, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = CachedAngularVector<T>::toPolar(input[i]);
+}
+
 #endif
\ No newline at end of file
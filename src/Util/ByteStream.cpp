@@ -0,0 +1,62 @@
+#include <Util/ByteStream.hpp>
+
+#include <cstring>
+
+void ByteWriter::u16(std::uint16_t v) {
+    output.push_back(v & 0xFF);
+    output.push_back(v >> 8);
+}
+
+void ByteWriter::u32(std::uint32_t v) {
+    for (unsigned int i = 0; i < 4; ++i)
+        output.push_back((v >> (i*8)) & 0xFF);
+}
+
+void ByteWriter::varint(std::uint32_t v) {
+    while (v >= 0x80) {
+        output.push_back((v & 0x7F) | 0x80);
+        v >>= 7;
+    }
+    output.push_back(v);
+}
+
+void ByteWriter::bytes(const void* data, std::size_t size) {
+    const std::size_t offset = output.size();
+    output.resize(offset + size);
+    if (size > 0)
+        std::memcpy(&output[offset], data, size);
+}
+
+std::uint16_t ByteReader::u16() {
+    const std::uint16_t low = u8();
+    return low | (static_cast<std::uint16_t>(u8()) << 8);
+}
+
+std::uint32_t ByteReader::u32() {
+    std::uint32_t v = 0;
+    for (unsigned int i = 0; i < 4; ++i)
+        v |= static_cast<std::uint32_t>(u8()) << (i*8);
+    return v;
+}
+
+std::uint32_t ByteReader::varint() {
+    std::uint32_t v = 0;
+    for (unsigned int shift = 0; shift < 35; shift += 7) {
+        const std::uint8_t b = u8();
+        v |= static_cast<std::uint32_t>(b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            return v;
+    }
+    failed = true;
+    return 0;
+}
+
+const std::uint8_t* ByteReader::bytes(std::size_t size) {
+    if (size > remaining()) {
+        failed = true;
+        return nullptr;
+    }
+    const std::uint8_t* start = cur;
+    cur += size;
+    return start;
+}
\ No newline at end of file
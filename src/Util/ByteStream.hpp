@@ -0,0 +1,95 @@
+#ifndef BYTESTREAM_HPP
+#define BYTESTREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Appends little endian integers and varints to a byte buffer. Shared by the binary formats that
+ * are built in memory and written in one go, such as snapshots and recordings
+ *
+ * \ingroup Util
+ */
+class ByteWriter {
+public:
+    /**
+     * Creates a writer that appends to the given buffer
+     */
+    explicit ByteWriter(std::vector<std::uint8_t>& output) : output(output) {}
+
+    void u8(std::uint8_t v) { output.push_back(v); }
+    void u16(std::uint16_t v);
+    void u32(std::uint32_t v);
+
+    /**
+     * Writes the value in 7 bit groups, low group first, so small values take a single byte
+     */
+    void varint(std::uint32_t v);
+
+    /**
+     * Writes the bytes as they are
+     */
+    void bytes(const void* data, std::size_t size);
+
+private:
+    std::vector<std::uint8_t>& output;
+};
+
+/**
+ * Cursor over data written by ByteWriter. Reads past the end return zero and leave the reader
+ * failed, so a format can read all of its fields and check for failure once
+ *
+ * \ingroup Util
+ */
+class ByteReader {
+public:
+    /**
+     * Creates a reader over the given bytes. The data must outlive the reader
+     */
+    ByteReader(const std::uint8_t* data, std::size_t size) : cur(data), end(data + size), failed(false) {}
+
+    std::uint8_t u8() {
+        if (cur >= end) {
+            failed = true;
+            return 0;
+        }
+        return *cur++;
+    }
+    std::uint16_t u16();
+    std::uint32_t u32();
+
+    /**
+     * Reads a value written by ByteWriter::varint(). Fails on values longer than 5 bytes
+     */
+    std::uint32_t varint();
+
+    /**
+     * Skips the given number of bytes
+     *
+     * \return The skipped bytes, or null if there are not enough left
+     */
+    const std::uint8_t* bytes(std::size_t size);
+
+    /**
+     * Returns the number of bytes left to read
+     */
+    std::size_t remaining() const { return end - cur; }
+
+    /**
+     * Marks the data as invalid, for checks done by the format itself
+     */
+    void fail() { failed = true; }
+
+    /**
+     * Returns true if a read went past the end or fail() was called
+     */
+    bool hasFailed() const { return failed; }
+
+private:
+    const std::uint8_t* cur;
+    const std::uint8_t* end;
+    bool failed;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef FASTTRIG_HPP
+#define FASTTRIG_HPP
+
+#include <cmath>
+
+/**
+ * Polynomial approximations of the trig functions used for angle conversions. Angles are in
+ * degrees. The functions have no branches on the input so loops over them vectorize
+ *
+ *  - sinCos: Absolute error below 4e-7 of the exact value. The reduction is done in degrees, so
+ *    std::sin of the angle converted to radians as a float differs by up to 8e-7 at a few turns
+ *  - atan2: Absolute error below 7e-4 degrees
+ */
+struct FastTrig {
+    static constexpr float Pi = 3.14159265f;
+    static constexpr float DegToRad = Pi / 180;
+    static constexpr float RadToDeg = 180 / Pi;
+
+    /**
+     * Computes the sine and cosine of the angle together
+     */
+    static void sinCos(float degrees, float& s, float& c) {
+        // Reduce to [-45, 45] degrees around the nearest quarter turn
+        const float quarters = std::nearbyint(degrees / 90);
+        const float x = (degrees - quarters * 90) * DegToRad;
+        const int quadrant = static_cast<int>(quarters) & 3;
+
+        const float x2 = x * x;
+        const float sx = x * (1 + x2 * (-1.f/6 + x2 * (1.f/120 + x2 * (-1.f/5040))));
+        const float cx = 1 + x2 * (-0.5f + x2 * (1.f/24 + x2 * (-1.f/720 + x2 * (1.f/40320))));
+
+        // Rotate the result by the removed quarter turns
+        const bool swap = quadrant & 1;
+        const float sign = (quadrant & 2) ? -1.f : 1.f;
+        s = sign * (swap ? cx : sx);
+        c = sign * (swap ? -sx : cx);
+    }
+
+    /**
+     * Returns the angle of the vector from the positive x axis in degrees, in [-180, 180]
+     */
+    static float atan2(float y, float x) {
+        const float ax = std::fabs(x);
+        const float ay = std::fabs(y);
+        const float mx = std::fmax(ax, ay);
+        const float t = mx > 0 ? std::fmin(ax, ay) / mx : 0;
+
+        // atan on [0, 1], Abramowitz and Stegun 4.4.49
+        const float t2 = t * t;
+        float a = t * (0.9998660f + t2 * (-0.3302995f + t2 * (0.1801410f + t2 * (-0.0851330f + t2 * 0.0208351f))));
+
+        a = ay > ax ? Pi / 2 - a : a;
+        a = x < 0 ? Pi - a : a;
+        a = y < 0 ? -a : a;
+        return a * RadToDeg;
+    }
+};
+
+#endif
\ No newline at end of file
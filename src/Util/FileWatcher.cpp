@@ -0,0 +1,137 @@
+#include <Util/FileWatcher.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace {
+std::string withSlash(const std::string& directory) {
+    if (!directory.empty() && directory.back() != '/')
+        return directory + "/";
+    return directory;
+}
+}
+
+#ifdef __linux__
+
+FileWatcher::FileWatcher() {
+    fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+        std::cerr << "Failed to initialize inotify. File changes will not be detected" << std::endl;
+}
+
+FileWatcher::~FileWatcher() {
+    if (fd >= 0)
+        close(fd);
+}
+
+bool FileWatcher::watch(const std::string& directory) {
+    std::error_code error;
+    if (fd < 0 || !std::filesystem::is_directory(directory, error))
+        return false;
+
+    addWatch(withSlash(directory));
+    for (auto i = std::filesystem::recursive_directory_iterator(directory, error);
+         i != std::filesystem::recursive_directory_iterator(); i.increment(error)) {
+        if (i->is_directory(error))
+            addWatch(withSlash(withSlash(directory) + std::filesystem::relative(i->path(), directory).generic_string()));
+    }
+    return true;
+}
+
+void FileWatcher::addWatch(const std::string& directory) {
+    const int wd = inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd < 0)
+        std::cerr << "Failed to watch directory: " << directory << std::endl;
+    else
+        directories[wd] = directory;
+}
+
+std::vector<std::string> FileWatcher::poll() {
+    std::vector<std::string> changed;
+    if (fd < 0)
+        return changed;
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        const ssize_t len = read(fd, buffer, sizeof(buffer));
+        if (len <= 0)
+            break;
+
+        for (ssize_t pos = 0; pos < len;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + pos);
+            pos += sizeof(inotify_event) + event->len;
+
+            auto dir = directories.find(event->wd);
+            if (dir == directories.end() || event->len == 0)
+                continue;
+
+            const std::string path = dir->second + event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    addWatch(withSlash(path));
+            }
+            else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                if (std::find(changed.begin(), changed.end(), path) == changed.end())
+                    changed.push_back(path);
+            }
+        }
+    }
+    return changed;
+}
+
+#else
+
+FileWatcher::FileWatcher()
+: lastScan(std::chrono::steady_clock::now()) {}
+
+FileWatcher::~FileWatcher() {}
+
+bool FileWatcher::watch(const std::string& directory) {
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error))
+        return false;
+
+    roots.push_back(withSlash(directory));
+    scan(roots.back(), nullptr);
+    return true;
+}
+
+void FileWatcher::scan(const std::string& directory, std::vector<std::string>* changed) {
+    std::error_code error;
+    for (auto i = std::filesystem::recursive_directory_iterator(directory, error);
+         i != std::filesystem::recursive_directory_iterator(); i.increment(error)) {
+        if (!i->is_regular_file(error))
+            continue;
+
+        const std::string path = directory + std::filesystem::relative(i->path(), directory).generic_string();
+        const std::filesystem::file_time_type modified = i->last_write_time(error);
+        auto previous = modifiedTimes.find(path);
+        if (previous == modifiedTimes.end() || previous->second != modified) {
+            modifiedTimes[path] = modified;
+            if (changed)
+                changed->push_back(path);
+        }
+    }
+}
+
+std::vector<std::string> FileWatcher::poll() {
+    // Scanning touches every file so only do it once a second
+    std::vector<std::string> changed;
+    const auto now = std::chrono::steady_clock::now();
+    if (now - lastScan < std::chrono::seconds(1))
+        return changed;
+
+    lastScan = now;
+    for (const std::string& root : roots)
+        scan(root, &changed);
+    return changed;
+}
+
+#endif
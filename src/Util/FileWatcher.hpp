@@ -0,0 +1,58 @@
+#ifndef FILEWATCHER_HPP
+#define FILEWATCHER_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Watches directories for modified files. Uses inotify on Linux and falls back to periodically
+ * checking modification times elsewhere. Changes are collected by polling from the main loop, so no
+ * threads are involved
+ */
+class FileWatcher {
+public:
+    /**
+     * Creates a watcher with no directories
+     */
+    FileWatcher();
+
+    /**
+     * Stops watching all directories
+     */
+    ~FileWatcher();
+
+    /**
+     * Watches the given directory and all of its subdirectories
+     *
+     * \param directory The directory to watch. Reported paths start with this
+     * \return True if the directory is being watched, false if it could not be
+     */
+    bool watch(const std::string& directory);
+
+    /**
+     * Returns the paths of files that were written to since the last call. Does not block
+     */
+    std::vector<std::string> poll();
+
+private:
+#ifdef __linux__
+    int fd;
+    std::map<int, std::string> directories;
+
+    void addWatch(const std::string& directory);
+#else
+    std::vector<std::string> roots;
+    std::map<std::string, std::filesystem::file_time_type> modifiedTimes;
+    std::chrono::steady_clock::time_point lastScan;
+
+    void scan(const std::string& directory, std::vector<std::string>* changed);
+#endif
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,333 @@
+#include <Util/JSON/CompiledSchema.hpp>
+
+#include <iostream>
+
+namespace {
+std::ostream& error(const JsonSourceInfo& info) {
+    std::cerr << "File " << info.filename << " line " << info.lineNumber << ": ";
+    return std::cerr;
+}
+
+/**
+ * Small buffer for per-group scratch data. Avoids heap allocation for typical group sizes
+ */
+class ScratchBuffer {
+public:
+    ScratchBuffer(unsigned int size, int value) : data(local) {
+        if (size > LocalSize) {
+            heap.resize(size);
+            data = heap.data();
+        }
+        for (unsigned int i = 0; i < size; ++i)
+            data[i] = value;
+    }
+
+    int& operator[](unsigned int i) { return data[i]; }
+
+private:
+    static constexpr unsigned int LocalSize = 32;
+
+    int local[LocalSize];
+    std::vector<int> heap;
+    int* data;
+};
+}
+
+CompiledSchema::CompiledSchema(const SchemaGroup& root) {
+    rootNode = compileGroup(root);
+}
+
+CompiledSchema::CompiledSchema(const SchemaValue& root) {
+    rootNode = compile(root);
+}
+
+unsigned int CompiledSchema::compile(const SchemaValue& value) {
+    const SchemaValue::TData& data = *value.data;
+
+    if (const SchemaGroup* group = std::get_if<SchemaGroup>(&data))
+        return compileGroup(*group);
+    if (const SchemaUnion* uGrp = std::get_if<SchemaUnion>(&data))
+        return compileUnion(*uGrp);
+
+    Node node = Node();
+    node.type = value.getType();
+
+    if (const SchemaList* list = std::get_if<SchemaList>(&data)) {
+        node.kind = Node::List;
+        node.hasMin = list->minLen.has_value();
+        node.hasMax = list->maxLen.has_value();
+        node.min = list->minLen.value_or(0);
+        node.max = list->maxLen.value_or(0);
+        node.child = compile(list->listType);
+    }
+    else if (auto limits = std::get_if<std::pair<std::optional<float>, std::optional<float> > >(&data)) {
+        node.kind = Node::Numeric;
+        node.hasMin = limits->first.has_value();
+        node.hasMax = limits->second.has_value();
+        node.min = limits->first.value_or(0);
+        node.max = limits->second.value_or(0);
+    }
+    else if (auto values = std::get_if<std::list<std::string> >(&data)) {
+        node.kind = Node::String;
+        node.first = strings.size();
+        node.count = values->size();
+        strings.insert(strings.end(), values->begin(), values->end());
+    }
+    else
+        node.kind = Node::Bool;
+
+    nodes.push_back(node);
+    return nodes.size() - 1;
+}
+
+unsigned int CompiledSchema::compileGroup(const SchemaGroup& group) {
+    Node node = Node();
+    node.kind = Node::Group;
+    node.type = JsonValue::Group;
+    node.overrideStrict = group.overrideStrict;
+    node.isStrict = group.isStrict;
+    node.first = fields.size();
+    node.count = group.schema.size();
+
+    const unsigned int index = nodes.size();
+    nodes.push_back(node);
+
+    // Reserve the field block so that nested groups compile after it
+    fields.resize(fields.size() + group.schema.size());
+    for (unsigned int i = 0; i < group.schema.size(); ++i) {
+        const SchemaGroup::Field& field = *group.schema[i];
+        const unsigned int child = compile(field.value);
+        fields[node.first + i] = {JsonKey::intern(field.name), child, field.required};
+    }
+
+    buildTable(nodes[index]);
+    return index;
+}
+
+unsigned int CompiledSchema::compileUnion(const SchemaUnion& group) {
+    Node node = Node();
+    node.kind = Node::Union;
+    node.type = JsonValue::Group;
+    node.nRequired = group.nRequiredFields;
+    node.first = fields.size();
+    node.count = group.fieldOptions.size();
+
+    const unsigned int index = nodes.size();
+    nodes.push_back(node);
+
+    // Options are kept in map order, which is the order they are listed in errors
+    fields.resize(fields.size() + group.fieldOptions.size());
+    unsigned int i = 0;
+    for (auto option = group.fieldOptions.begin(); option != group.fieldOptions.end(); ++option, ++i) {
+        const unsigned int child = compile(option->second);
+        fields[node.first + i] = {JsonKey::intern(option->first), child, false};
+    }
+
+    buildTable(nodes[index]);
+    return index;
+}
+
+void CompiledSchema::buildTable(Node& node) {
+    unsigned int size = 1;
+    while (size < node.count * 2)
+        size *= 2;
+
+    node.tableFirst = tables.size();
+    node.tableMask = size - 1;
+    tables.resize(tables.size() + size, 0);
+
+    for (unsigned int i = 0; i < node.count; ++i) {
+        unsigned int slot = fields[node.first + i].name.hash() & node.tableMask;
+        while (tables[node.tableFirst + slot] != 0)
+            slot = (slot + 1) & node.tableMask;
+        tables[node.tableFirst + slot] = i + 1;
+    }
+}
+
+int CompiledSchema::lookup(const Node& node, JsonKey key) const {
+    unsigned int slot = key.hash() & node.tableMask;
+    while (true) {
+        const unsigned int entry = tables[node.tableFirst + slot];
+        if (entry == 0)
+            return -1;
+        if (fields[node.first + entry - 1].name == key)
+            return entry - 1;
+        slot = (slot + 1) & node.tableMask;
+    }
+}
+
+bool CompiledSchema::validate(const JsonGroup& data, bool strict) const {
+    const Node& root = nodes[rootNode];
+    if (root.kind == Node::Union)
+        return validateUnion(root, data, strict);
+    return validateGroup(root, data, strict);
+}
+
+bool CompiledSchema::validate(const JsonValue& value, bool strict) const {
+    return validateValue(nodes[rootNode], value, strict);
+}
+
+unsigned int CompiledSchema::fieldCount() const {
+    const Node& root = nodes[rootNode];
+    return root.kind == Node::Group || root.kind == Node::Union ? root.count : 0;
+}
+
+JsonKey CompiledSchema::fieldName(unsigned int i) const {
+    return fields[nodes[rootNode].first + i].name;
+}
+
+int CompiledSchema::findField(JsonKey key) const {
+    const Node& root = nodes[rootNode];
+    if (root.kind != Node::Group && root.kind != Node::Union)
+        return -1;
+    return lookup(root, key);
+}
+
+bool CompiledSchema::validateGroup(const Node& node, const JsonGroup& group, bool strict) const {
+    const bool beStrict = node.overrideStrict ? node.isStrict : strict;
+
+    // Single pass over the data to pair each schema field with its json field
+    ScratchBuffer matches(node.count, -1);
+    ScratchBuffer extras(group.fieldCount(), 0);
+    bool hasExtras = false;
+    for (unsigned int i = 0; i < group.fieldCount(); ++i) {
+        const int field = lookup(node, group.fieldAt(i).getKey());
+        if (field >= 0)
+            matches[field] = i;
+        else {
+            extras[i] = 1;
+            hasExtras = true;
+        }
+    }
+
+    bool valid = true;
+    for (unsigned int i = 0; i < node.count; ++i) {
+        const Field& field = fields[node.first + i];
+        if (matches[i] < 0) {
+            if (field.required) {
+                error(group.info()) << "JsonGroup is missing field: " << field.name.str() << std::endl;
+                valid = false;
+            }
+        }
+        else {
+            const JsonValue& value = group.fieldAt(matches[i]).getValue();
+            if (!validateValue(nodes[field.node], value, beStrict)) {
+                error(value.info()) << "Field '" << field.name.str() << "' failed to validate" << std::endl;
+                valid = false;
+            }
+        }
+    }
+
+    if (beStrict && hasExtras) {
+        error(group.info()) << "JsonGroup has extra fields: ";
+        for (unsigned int i = 0; i < group.fieldCount(); ++i) {
+            if (extras[i])
+                std::cerr << group.fieldAt(i).getName() << ", ";
+        }
+        std::cerr << std::endl;
+        valid = false;
+    }
+
+    return valid;
+}
+
+bool CompiledSchema::validateUnion(const Node& node, const JsonGroup& group, bool strict) const {
+    bool valid = true;
+
+    if (group.fieldCount() != node.nRequired) {
+        error(group.info()) << "Expected " << node.nRequired << " got " << group.fieldCount() << std::endl;
+        valid = false;
+    }
+
+    unsigned int found = 0;
+    for (unsigned int i = 0; i < group.fieldCount(); ++i) {
+        const JsonField& jsonField = group.fieldAt(i);
+        const int field = lookup(node, jsonField.getKey());
+        if (field < 0) {
+            error(group.info()) << "Unexpected field '" << jsonField.getName() << "'\n";
+            valid = false;
+        }
+        else {
+            found += 1;
+            if (!validateValue(nodes[fields[node.first + field].node], jsonField.getValue(), strict))
+                valid = false;
+        }
+    }
+
+    if (found != node.nRequired) {
+        error(group.info()) << node.nRequired << " fields required from [";
+        for (unsigned int i = 0; i < node.count; ++i)
+            std::cerr << "'" << fields[node.first + i].name.str() << "', ";
+        std::cerr << "]. " << found << " are present" << std::endl;
+        valid = false;
+    }
+
+    return valid;
+}
+
+bool CompiledSchema::validateValue(const Node& node, const JsonValue& value, bool strict) const {
+    if (node.type != value.getType()) {
+        error(value.info()) << "Invalid JsonValue type: Expecting " << node.type << " got " << value.getType() << std::endl;
+        return false;
+    }
+
+    switch (node.kind) {
+    case Node::Numeric: {
+            const float val = *value.getAsNumeric();
+            if (node.hasMin && val < node.min) {
+                error(value.info()) << "Numeric JsonValue is too low. Min: " << node.min << std::endl;
+                return false;
+            }
+            if (node.hasMax && val > node.max) {
+                error(value.info()) << "Numeric JsonValue is too high. Max: " << node.max << std::endl;
+                return false;
+            }
+        }
+        return true;
+
+    case Node::String: {
+            if (node.count == 0)
+                return true;
+            const std::string_view val = *value.getAsString();
+            for (unsigned int i = 0; i < node.count; ++i) {
+                if (strings[node.first + i] == val)
+                    return true;
+            }
+            error(value.info()) << '"' << val << "' is not a valid String value. Must be in [";
+            std::cerr << '"' << strings[node.first] << '"';
+            for (unsigned int i = 0; i < node.count; ++i)
+                std::cerr << ", \"" << strings[node.first + i] << '"';
+            std::cerr << "]" << std::endl;
+        }
+        return false;
+
+    case Node::Group:
+        return validateGroup(node, *value.getAsGroup(), strict);
+
+    case Node::Union:
+        return validateUnion(node, *value.getAsGroup(), strict);
+
+    case Node::List: {
+            const JsonList& list = *value.getAsList();
+            if (node.hasMin && list.size() < node.min)
+                error(value.info()) << "List size is too small: Min " << node.min << " actual " << list.size() << std::endl;
+            if (node.hasMax && list.size() > node.max)
+                error(value.info()) << "List size is too big: Max " << node.max << " actual " << list.size() << std::endl;
+
+            const Node& child = nodes[node.child];
+            bool valid = true;
+            for (unsigned int i = 0; i < list.size(); ++i) {
+                if (!validateValue(child, list[i], strict))
+                    valid = false;
+            }
+            return valid;
+        }
+
+    case Node::Bool:
+        return true;
+
+    default:
+        error(value.info()) << "SchemaValue errpr: Invalid type " << node.type << std::endl;
+        return false;
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef COMPILEDSCHEMA_HPP
+#define COMPILEDSCHEMA_HPP
+
+#include <Util/JSON/SchemaTypes.hpp>
+#include <vector>
+
+/**
+ * Flattened form of a schema. The SchemaGroup tree is compiled once into contiguous node and field
+ * tables, and each group gets an open addressed table of its interned, pre-hashed field names.
+ * Validation is then a single pass over the json with no string comparisons or map lookups. Error
+ * output is identical to validating with the schema tree directly
+ */
+class CompiledSchema {
+public:
+    /**
+     * Compiles the given schema
+     */
+    explicit CompiledSchema(const SchemaGroup& root);
+
+    /**
+     * Compiles the given schema value. Used for leaf values bound outside of a group schema
+     */
+    explicit CompiledSchema(const SchemaValue& root);
+
+    /**
+     * Validates the given JsonGroup against a group or union schema
+     *
+     * \param data The data to validate
+     * \param strict Whether or not extra fields are considered errors
+     */
+    bool validate(const JsonGroup& data, bool strict) const;
+
+    /**
+     * Validates the given JsonValue
+     *
+     * \param value The value to validate
+     * \param strict Whether or not extra fields are considered errors
+     */
+    bool validate(const JsonValue& value, bool strict) const;
+
+    /**
+     * Returns the number of fields of the root group or union. Union options are in name order
+     */
+    unsigned int fieldCount() const;
+
+    /**
+     * Returns the name of the i'th field of the root group or union
+     */
+    JsonKey fieldName(unsigned int i) const;
+
+    /**
+     * Returns the index of the root field with the given name, or -1 if there is none
+     */
+    int findField(JsonKey key) const;
+
+private:
+    struct Node {
+        enum Kind {
+            Bool,
+            String,
+            Numeric,
+            Group,
+            Union,
+            List
+        };
+
+        Kind kind;
+        JsonValue::Type type;
+
+        // Numeric bounds or list length bounds
+        bool hasMin, hasMax;
+        float min, max;
+
+        // Group and union fields, string values
+        unsigned int first, count;
+
+        // Group and union field lookup table
+        unsigned int tableFirst, tableMask;
+
+        // Group strictness, union required field count
+        bool overrideStrict, isStrict;
+        unsigned int nRequired;
+
+        // List element type
+        unsigned int child;
+    };
+
+    struct Field {
+        JsonKey name;
+        unsigned int node;
+        bool required;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Field> fields;
+    std::vector<unsigned int> tables;
+    std::vector<std::string> strings;
+    unsigned int rootNode;
+
+    unsigned int compile(const SchemaValue& value);
+    unsigned int compileGroup(const SchemaGroup& group);
+    unsigned int compileUnion(const SchemaUnion& group);
+    void buildTable(Node& node);
+
+    int lookup(const Node& node, JsonKey key) const;
+    bool validateValue(const Node& node, const JsonValue& value, bool strict) const;
+    bool validateGroup(const Node& node, const JsonGroup& group, bool strict) const;
+    bool validateUnion(const Node& node, const JsonGroup& group, bool strict) const;
+};
+
+#endif
\ No newline at end of file
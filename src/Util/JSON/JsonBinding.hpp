@@ -0,0 +1,210 @@
+#ifndef JSONBINDING_HPP
+#define JSONBINDING_HPP
+
+#include <Util/JSON/CompiledSchema.hpp>
+#include <Util/JSON/SchemaTypes.hpp>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * Declarative mapping from a JsonGroup onto a C++ struct. Each field is bound to a member along
+ * with the schema it must satisfy. The equivalent SchemaValue can be generated from the binding so
+ * that the binding is the single definition of a file format
+ *
+ * Loading validates the whole group through the CompiledSchema of the binding, so errors are the
+ * same as validating against the schema, then assigns every bound field in a second pass. Nested
+ * bindings only assign, since the outermost validation already covered them
+ *
+ * Bindings with makeUnion() set behave like a SchemaUnion: the bound fields are options and exactly
+ * the required number of them must be present. Union options are bound to std::optional members
+ */
+template<typename T>
+class JsonBinding {
+public:
+    /**
+     * Creates an empty binding
+     *
+     * \param overrideStrict True to ignore the strictness passed in when loading
+     * \param isStrict The strictness to use when overrideStrict is true
+     */
+    explicit JsonBinding(bool overrideStrict = false, bool isStrict = false)
+    : overrideStrict(overrideStrict), isStrict(isStrict), nUnionFields(0) {
+        compile();
+    }
+
+    /**
+     * Binds a required leaf value (number, bool or string) to the given member
+     */
+    template<typename M>
+    JsonBinding& expect(const std::string& name, M T::* member, const SchemaValue& schema) {
+        return addLeaf(name, member, schema, true);
+    }
+
+    /**
+     * Binds an optional leaf value to the given member. The member is left untouched if missing
+     */
+    template<typename M>
+    JsonBinding& optional(const std::string& name, M T::* member, const SchemaValue& schema) {
+        return addLeaf(name, member, schema, false);
+    }
+
+    /**
+     * Binds a required nested group to the given member
+     */
+    template<typename M>
+    JsonBinding& expect(const std::string& name, M T::* member, const JsonBinding<M>& binding) {
+        addField({JsonKey::intern(name), true, binding.schema(),
+            [member, binding](const JsonValue& value, T& out) {
+                binding.assign(*value.getAsGroup(), out.*member);
+            }
+        });
+        return *this;
+    }
+
+    /**
+     * Binds a required list of groups to the given member
+     */
+    template<typename M>
+    JsonBinding& expect(const std::string& name, std::vector<M> T::* member, const JsonBinding<M>& binding) {
+        addField({JsonKey::intern(name), true, SchemaValue(SchemaList(binding.schema())),
+            [member, binding](const JsonValue& value, T& out) {
+                const JsonList& list = *value.getAsList();
+                std::vector<M>& dest = out.*member;
+                dest.clear();
+                dest.resize(list.size());
+                for (unsigned int i = 0; i < list.size(); ++i)
+                    binding.assign(*list[i].getAsGroup(), dest[i]);
+            }
+        });
+        return *this;
+    }
+
+    /**
+     * Binds an optional nested group. Used for the options of a union
+     */
+    template<typename M>
+    JsonBinding& option(const std::string& name, std::optional<M> T::* member, const JsonBinding<M>& binding) {
+        addField({JsonKey::intern(name), false, binding.schema(),
+            [member, binding](const JsonValue& value, T& out) {
+                (out.*member).emplace();
+                binding.assign(*value.getAsGroup(), *(out.*member));
+            }
+        });
+        return *this;
+    }
+
+    /**
+     * Makes this binding a union where the given number of fields must be present
+     */
+    JsonBinding& makeUnion(unsigned int nRequired = 1) {
+        nUnionFields = nRequired;
+        compile();
+        return *this;
+    }
+
+    /**
+     * Returns the schema equivalent to this binding
+     */
+    SchemaValue schema() const {
+        if (nUnionFields > 0) {
+            SchemaUnion unionGroup(nUnionFields);
+            for (const Field& field : fields)
+                unionGroup.addFieldOption(field.name.str(), field.schema);
+            return SchemaValue(unionGroup);
+        }
+        return SchemaValue(schemaGroup());
+    }
+
+    /**
+     * Returns the schema group equivalent to this binding. Not valid for unions
+     */
+    SchemaGroup schemaGroup() const {
+        SchemaGroup group(overrideStrict, isStrict);
+        for (const Field& field : fields) {
+            if (field.required)
+                group.addExpectedField(field.name.str(), field.schema);
+            else
+                group.addOptionalField(field.name.str(), field.schema);
+        }
+        return group;
+    }
+
+    /**
+     * Validates the group and assigns all bound fields
+     *
+     * \param data The json to load from
+     * \param out The object to populate
+     * \param strict Whether or not extra fields are considered errors
+     * \return True if the data was valid. The output is left untouched on failure
+     */
+    bool load(const JsonGroup& data, T& out, bool strict) const {
+        if (!compiled->validate(data, strict))
+            return false;
+        assign(data, out);
+        return true;
+    }
+
+    /**
+     * Assigns all bound fields without validating. The data must have passed validation
+     */
+    void assign(const JsonGroup& data, T& out) const {
+        for (unsigned int i = 0; i < data.fieldCount(); ++i) {
+            const JsonField& jsonField = data.fieldAt(i);
+            const int index = compiled->findField(jsonField.getKey());
+            if (index >= 0)
+                fields[order[index]].assign(jsonField.getValue(), out);
+        }
+    }
+
+private:
+    struct Field {
+        JsonKey name;
+        bool required;
+        SchemaValue schema;
+        std::function<void(const JsonValue&, T&)> assign;
+    };
+
+    bool overrideStrict;
+    bool isStrict;
+    unsigned int nUnionFields;
+    std::vector<Field> fields;
+
+    std::shared_ptr<const CompiledSchema> compiled;
+    std::vector<unsigned int> order; // index in fields of each compiled field
+
+    void addField(Field&& field) {
+        fields.push_back(std::move(field));
+        compile();
+    }
+
+    void compile() {
+        // Bindings are built once at startup, so the schema is simply compiled again for every field
+        compiled = std::make_shared<const CompiledSchema>(schema());
+        order.resize(compiled->fieldCount());
+        for (unsigned int i = 0; i < order.size(); ++i) {
+            for (unsigned int j = 0; j < fields.size(); ++j) {
+                if (fields[j].name == compiled->fieldName(i))
+                    order[i] = j;
+            }
+        }
+    }
+
+    static void assignLeaf(const JsonValue& value, float& out) { out = *value.getAsNumeric(); }
+    static void assignLeaf(const JsonValue& value, bool& out) { out = *value.getAsBool(); }
+    static void assignLeaf(const JsonValue& value, std::string& out) { out.assign(*value.getAsString()); }
+
+    template<typename M>
+    JsonBinding& addLeaf(const std::string& name, M T::* member, const SchemaValue& schema, bool required) {
+        addField({JsonKey::intern(name), required, schema,
+            [member](const JsonValue& value, T& out) {
+                assignLeaf(value, out.*member);
+            }
+        });
+        return *this;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -2,30 +2,36 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
+#include <cstring>
 
-JsonLoader::JsonLoader(const std::string& file)
-: valid(true), filename(file), cLine(1) {
-    std::ifstream input(file.c_str());
-    std::string buffer;
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
+JsonLoader::JsonLoader(const std::string& file)
+: valid(true), filename(JsonKey::intern(file)), cLine(1), arena(&ownArena) {
+    std::ifstream input(file.c_str(), std::ios::in | std::ios::binary);
     input.seekg(0, std::ios::end);
-    buffer.reserve(input.tellg());
+    const std::streamoff size = input.tellg();
     input.seekg(0, std::ios::beg);
-    buffer.assign((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (size > 0) {
+        data.resize(size);
+        input.read(&data[0], size);
+        data.resize(input.gcount());
+    }
 
-    data.str(buffer);
+    cur = data.data();
+    end = cur + data.size();
     skipWhitespace();
 }
 
-JsonLoader::JsonLoader(std::istream& input) : valid(true), cLine(1) {
-    std::string buffer;
-
-    input.seekg(0, std::ios::end);
-    buffer.reserve(input.tellg());
-    input.seekg(0, std::ios::beg);
-    buffer.assign((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+JsonLoader::JsonLoader(std::istream& input)
+: valid(true), cLine(1), arena(&ownArena) {
+    data.assign((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
 
-    data.str(buffer);
+    cur = data.data();
+    end = cur + data.size();
     skipWhitespace();
 }
 
@@ -34,77 +40,121 @@ int JsonLoader::currentLine() const {
 }
 
 const std::string& JsonLoader::getFilename() const {
-    return filename;
+    return filename.str();
+}
+
+std::size_t JsonLoader::inputSize() const {
+    return data.size();
+}
+
+void JsonLoader::setArena(std::pmr::memory_resource* a) {
+    arena = a;
+}
+
+std::pmr::memory_resource* JsonLoader::getArena() const {
+    return arena;
+}
+
+std::string_view JsonLoader::copyToArena(std::string_view str) {
+    if (str.empty())
+        return std::string_view();
+    char* mem = static_cast<char*>(arena->allocate(str.size(), 1));
+    std::memcpy(mem, str.data(), str.size());
+    return std::string_view(mem, str.size());
 }
 
 std::ostream& JsonLoader::error() {
     valid = false;
-    std::cerr << "Error: file " << filename << " line " << cLine << ": ";
+    std::cerr << "Error: file " << filename.str() << " line " << cLine << ": ";
     return std::cerr;
 }
 
 bool JsonLoader::isValid() {
-    return valid && data.good();
+    return valid && cur < end;
 }
 
 char JsonLoader::peekNextSymbol() {
-    return data.peek();
+    return cur < end ? *cur : static_cast<char>(EOF);
 }
 
 void JsonLoader::skipSymbol() {
     if (isValid()) {
-        data.get();
+        ++cur;
         skipWhitespace();
     }
 }
 
 std::string JsonLoader::loadString() {
+    return std::string(loadStringView());
+}
+
+std::string_view JsonLoader::loadStringView() {
     if (isValid()) {
         if (peekNextSymbol() == '"') {
-            std::string ret;
-            data.get();
-            while (data.peek() != '"') {
-                if (data.peek() == '\n')
-                    cLine += 1;
-
-                ret.push_back(data.get());
-                if (!data.good()) {
-                    valid = false;
-                    std::cerr << "Unexpected end of file" << std::endl;
-                    return "";
+            ++cur;
+            const char* start = cur;
+
+#ifdef __SSE2__
+            // Scan 16 bytes at a time for the closing quote, counting newlines on the way
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i newline = _mm_set1_epi8('\n');
+            while (end - cur >= 16) {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+                const unsigned int quotes = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote));
+                const unsigned int newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+                if (quotes != 0) {
+                    const unsigned int stop = __builtin_ctz(quotes);
+                    cLine += __builtin_popcount(newlines & ((1u << stop) - 1));
+                    cur += stop;
+                    break;
                 }
+                cLine += __builtin_popcount(newlines);
+                cur += 16;
+            }
+#endif
+
+            while (cur < end && *cur != '"') {
+                if (*cur == '\n')
+                    cLine += 1;
+                ++cur;
+            }
+            if (cur >= end) {
+                valid = false;
+                std::cerr << "Unexpected end of file" << std::endl;
+                return std::string_view();
             }
+
+            const std::string_view ret(start, cur - start);
             skipSymbol(); // closing quote
             return ret;
         }
         error() << "Unxpected symbol '" << peekNextSymbol() << "' expecting '\"'" << std::endl;
         valid = false;
     }
+    return std::string_view();
 }
 
 bool JsonLoader::loadBool(bool& value) {
     if (peekNextSymbol() == 't' || peekNextSymbol() == 'f') {
-        std::string word;
-        while (!isWhitespace(data.peek()) && data.good()) {
-            word.push_back(data.get());
-            if (word == "true") {
-                value = true;
-                skipWhitespace();
-                return true;
-            }
-            if (word == "false") {
-                value = false;
-                skipWhitespace();
-                return true;
-            }
-            if (word.size() > 5) {
-                error() << "Expected boolean value but too many characters" << std::endl;
-                valid = false;
-                return false;
-            }
+        const std::size_t remaining = end - cur;
+        if (remaining >= 4 && std::memcmp(cur, "true", 4) == 0) {
+            value = true;
+            cur += 4;
+            skipWhitespace();
+            return true;
+        }
+        if (remaining >= 5 && std::memcmp(cur, "false", 5) == 0) {
+            value = false;
+            cur += 5;
+            skipWhitespace();
+            return true;
         }
-        if (data.good()) {
-            error() << "'" << word << "' is not a boolean value" << std::endl;
+
+        const char* wordEnd = cur;
+        while (wordEnd < end && !isWhitespace(*wordEnd) && wordEnd - cur <= 5)
+            ++wordEnd;
+        if (wordEnd < end) {
+            error() << "'" << std::string_view(cur, wordEnd - cur) << "' is not a boolean value" << std::endl;
             valid = false;
             return false;
         }
@@ -131,27 +181,35 @@ float JsonLoader::loadNumeric() {
     if (isValid()) {
         const char c = peekNextSymbol();
         if (c == '-' || (c >= '0' && c <= '9')) {
-            std::string num;
-            num.push_back(data.get());
+            const char* start = cur;
             bool decimal = false;
 
-            while (isNumber(data.peek()) || data.peek() == '.') {
-                if (data.peek() == '.' && decimal) {
+            ++cur;
+            while (cur < end && (isNumber(*cur) || *cur == '.')) {
+                if (*cur == '.' && decimal) {
                     error() << "Too many decimal points in number" << std::endl;
                     return 0;
                 }
-                else if (data.peek() == '.')
+                else if (*cur == '.')
                     decimal = true;
-
-                num.push_back(data.get());
-                if (!data.good()) {
-                    error() << "Unexpected end of file";
-                    valid = false;
-                    return 0;
+                ++cur;
+            }
+            // Only the scanned token is parsed. It is copied out since the buffer may end right after it
+            const std::size_t length = cur - start;
+            char token[64];
+            char* parsed = token;
+            if (length < sizeof(token)) {
+                std::memcpy(token, start, length);
+                token[length] = '\0';
+                const float value = std::strtod(token, &parsed);
+                if (parsed == token + length) {
+                    skipWhitespace();
+                    return value;
                 }
             }
-            skipWhitespace();
-            return std::stod(num);
+            error() << "Invalid number " << std::string(start, length) << std::endl;
+            valid = false;
+            return 0;
         }
         else {
             error() << "Invalid numeric symbol " << c << std::endl;
@@ -166,9 +224,24 @@ bool JsonLoader::isWhitespace(char c) {
 }
 
 void JsonLoader::skipWhitespace() {
-    while (data.good() && isWhitespace(data.peek())) {
-        if (data.peek() == '\n')
+    while (cur < end) {
+#ifdef __SSE2__
+        // Indentation produces long runs of spaces, skip them 16 bytes at a time
+        const __m128i space = _mm_set1_epi8(' ');
+        while (end - cur >= 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur));
+            const unsigned int spaces = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, space));
+            if (spaces != 0xFFFF) {
+                cur += __builtin_ctz(~spaces);
+                break;
+            }
+            cur += 16;
+        }
+#endif
+        if (cur >= end || !isWhitespace(*cur))
+            break;
+        if (*cur == '\n')
             cLine += 1;
-        data.get();
+        ++cur;
     }
-}
\ No newline at end of file
+}
@@ -1,10 +1,15 @@
 #ifndef JSONLOADER_HPP
 #define JSONLOADER_HPP
 
-#include <sstream>
+#include <Util/JSON/JsonTypes.hpp>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <memory_resource>
 
 /**
- * Utility class to load json from files, streams, and strings
+ * Utility class to load json from files, streams, and strings. The input is read into a single
+ * contiguous buffer up front and parsed in place by scanning a pointer over it
  */
 class JsonLoader {
 public:
@@ -12,7 +17,7 @@ public:
     JsonLoader(std::istream& stream);
 
     /**
-     * Returns if the input stream is still valid
+     * Returns if the input is still valid and not exhausted
      */
     bool isValid();
 
@@ -26,6 +31,28 @@ public:
      */
     const std::string& getFilename() const;
 
+    /**
+     * Returns the size of the input in bytes. Useful for sizing the arena up front
+     */
+    std::size_t inputSize() const;
+
+    /**
+     * Sets the memory resource that loaded values allocate from. Nothing loaded is freed on its
+     * own, so the resource should release everything at once, like an arena. Defaults to an arena
+     * owned by the loader, in which case loaded values only live as long as the loader
+     */
+    void setArena(std::pmr::memory_resource* arena);
+
+    /**
+     * Returns the memory resource that loaded values allocate from
+     */
+    std::pmr::memory_resource* getArena() const;
+
+    /**
+     * Copies the given string into the arena and returns a view of the copy
+     */
+    std::string_view copyToArena(std::string_view str);
+
     /**
      * Skips whitespace and peeks next symbol
      */
@@ -41,6 +68,12 @@ public:
      */
     std::string loadString();
 
+    /**
+     * Loads a quote enclosed string value without copying it. The returned view points into the
+     * internal buffer and is only valid for the lifetime of the loader
+     */
+    std::string_view loadStringView();
+
     /**
      * Loads the next numeric value
      */
@@ -63,9 +96,16 @@ public:
 
 private:
     bool valid;
-    std::stringstream data;
-    std::string filename;
+    std::string data;
+    const char* cur;
+    const char* end;
+    JsonKey filename;
     int cLine;
+    std::pmr::monotonic_buffer_resource ownArena;
+    std::pmr::memory_resource* arena;
+
+    JsonLoader(const JsonLoader&) = delete;
+    JsonLoader& operator=(const JsonLoader&) = delete;
 
     void skipWhitespace();
 
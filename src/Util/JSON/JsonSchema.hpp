@@ -1,18 +1,20 @@
 #ifndef JSONSCHEMA_HPP
 #define JSONSCHEMA_HPP
 
+#include <Util/JSON/CompiledSchema.hpp>
 #include <Util/JSON/SchemaTypes.hpp>
 #include <Util/JsonFile.hpp>
 
 /**
- * Validates a JsonFile object by defining a schema for it
+ * Validates a JsonFile object by defining a schema for it. The schema is compiled once on
+ * construction and validation runs against the compiled form
  */
 class JsonSchema {
 public:
     /**
      * Defines a schema with the given root group object
      */
-    JsonSchema(const SchemaGroup& root) : root(root) {}
+    JsonSchema(const SchemaGroup& root) : root(root), compiled(root) {}
 
     /**
      * Returns the root object
@@ -25,7 +27,7 @@ public:
      * \param file The data to validate
      * \param strict Whether or not extra fields are considered errors
      */
-    bool validate(const JsonFile& file, bool strict) const { return root.validate(file.getRoot(), strict); }
+    bool validate(const JsonFile& file, bool strict) const { return compiled.validate(file.getRoot(), strict); }
 
     /**
      * Validates the given JsonGroup
@@ -33,10 +35,11 @@ public:
      * \param data The data to validate
      * \param strict Whether or not extra fields are considered errors
      */
-    bool validate(const JsonGroup& data, bool strict) const { return root.validate(data, strict); }
+    bool validate(const JsonGroup& data, bool strict) const { return compiled.validate(data, strict); }
 
 private:
     const SchemaGroup root;
+    const CompiledSchema compiled;
 };
 
 #endif
\ No newline at end of file
@@ -1,22 +1,79 @@
 #include <Util/JSON/JsonTypes.hpp>
 
 #include <Util/JSON/JsonLoader.hpp>
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+struct KeyHash {
+    std::size_t operator()(std::string_view str) const { return JsonKey::hash(str); }
+};
+
+/**
+ * Global table of interned strings. Entries are never removed so references stay valid
+ */
+class KeyTable {
+public:
+    static KeyTable& get() {
+        static KeyTable table;
+        return table;
+    }
+
+    template<typename TEntry>
+    const TEntry* intern(std::string_view str) {
+        std::lock_guard<std::mutex> guard(lock);
+        auto iter = entries.find(str);
+        if (iter != entries.end())
+            return static_cast<const TEntry*>(iter->second);
+
+        const std::size_t hash = JsonKey::hash(str);
+        storage.emplace_back(new TEntry{std::string(str), hash});
+        const TEntry* entry = static_cast<const TEntry*>(storage.back().get());
+        entries.emplace(entry->value, entry);
+        return entry;
+    }
+
+private:
+    std::mutex lock;
+    std::vector<std::shared_ptr<const void> > storage;
+    std::unordered_map<std::string_view, const void*, KeyHash> entries;
+};
+}
+
+JsonKey::JsonKey() : JsonKey(intern("")) {}
+
+JsonKey JsonKey::intern(std::string_view str) {
+    return JsonKey(KeyTable::get().intern<Entry>(str));
+}
+
+std::size_t JsonKey::hash(std::string_view str) {
+    // FNV-1a
+    std::uint64_t h = 14695981039346656037ull;
+    for (const char c : str) {
+        h ^= static_cast<unsigned char>(c);
+        h *= 1099511628211ull;
+    }
+    return static_cast<std::size_t>(h);
+}
 
 JsonValue::JsonValue(bool value)
 : type(Bool), data(value) {}
 
-JsonValue::JsonValue(const std::string& value)
+JsonValue::JsonValue(std::string_view value)
 : type(String), data(value) {}
 
 JsonValue::JsonValue(float value)
 : type(Numeric), data(value) {}
 
-JsonValue::JsonValue(const JsonList& value)
-: type(List), data(value) {}
+JsonValue::JsonValue(JsonList&& value)
+: type(List), data(std::move(value)) {}
 
-JsonValue::JsonValue(const JsonGroup& value)
-: type(Group), data(value) {}
+JsonValue::JsonValue(JsonGroup&& value)
+: type(Group), data(std::move(value)) {}
 
 JsonValue::Type JsonValue::getType() const {
     return type;
@@ -26,8 +83,8 @@ const bool* JsonValue::getAsBool() const {
     return std::get_if<bool>(&data);
 }
 
-const std::string* JsonValue::getAsString() const {
-    return std::get_if<std::string>(&data);
+const std::string_view* JsonValue::getAsString() const {
+    return std::get_if<std::string_view>(&data);
 }
 
 const float* JsonValue::getAsNumeric() const {
@@ -42,27 +99,51 @@ const JsonGroup* JsonValue::getAsGroup() const {
     return std::get_if<JsonGroup>(&data);
 }
 
-void JsonGroup::addField(const std::string& name, const JsonField& field) {
-    if (fields.find(name) != fields.end()) {
-        std::cerr << "Warning: Overwriting field \"" << name << "\" in JsonGroup" << std::endl;
+JsonGroup::JsonGroup(std::pmr::memory_resource* arena)
+: fields(arena), sorted(arena) {}
+
+std::pmr::vector<unsigned int>::const_iterator JsonGroup::find(std::string_view name) const {
+    auto iter = std::lower_bound(sorted.begin(), sorted.end(), name,
+        [this](unsigned int i, std::string_view n) { return fields[i].getName() < n; }
+    );
+    if (iter != sorted.end() && fields[*iter].getName() == name)
+        return iter;
+    return sorted.end();
+}
+
+void JsonGroup::addField(JsonField&& field) {
+    auto iter = find(field.getName());
+    if (iter != sorted.end()) {
+        std::cerr << "Warning: Overwriting field \"" << field.getName() << "\" in JsonGroup" << std::endl;
+        fields[*iter] = std::move(field);
+        return;
     }
-    fields.insert(std::make_pair(name, field));
-    fieldNames.push_back(name);
+
+    const std::string_view name = field.getName();
+    const auto pos = std::lower_bound(sorted.begin(), sorted.end(), name,
+        [this](unsigned int i, std::string_view n) { return fields[i].getName() < n; }
+    );
+    sorted.insert(pos, fields.size());
+    fields.push_back(std::move(field));
 }
 
-bool JsonGroup::hasField(const std::string& name) const {
-    return fields.find(name) != fields.end();
+bool JsonGroup::hasField(std::string_view name) const {
+    return find(name) != sorted.end();
 }
 
-const JsonValue* JsonGroup::getField(const std::string& name) const {
-    auto iter = fields.find(name);
-    if (iter != fields.end())
-        return &iter->second.getValue();
+const JsonValue* JsonGroup::getField(std::string_view name) const {
+    auto iter = find(name);
+    if (iter != sorted.end())
+        return &fields[*iter].getValue();
     return nullptr;
 }
 
 const std::vector<std::string> JsonGroup::getFields() const {
-    return fieldNames;
+    std::vector<std::string> names;
+    names.reserve(fields.size());
+    for (const JsonField& field : fields)
+        names.push_back(field.getName());
+    return names;
 }
 
 //                  OUTPUT
@@ -111,9 +192,9 @@ void JsonGroup::print(std::ostream& stream, int ilvl) const {
     stream << "{";
     if (fields.size() > 0)
         stream << '\n';
-    for (auto i = fields.begin(); i!=fields.end(); ++i) {
+    for (unsigned int i : sorted) {
         stream << std::string(ilvl, ' ');
-        i->second.print(stream, ilvl+4);
+        fields[i].print(stream, ilvl+4);
     }
     stream << std::string(ilvl-4, ' ') << "}," << std::endl;
 }
@@ -141,33 +222,32 @@ void JsonValue::print(std::ostream& stream, int ilvl) const {
 //                     LOADING
 
 JsonGroup JsonGroup::load(JsonLoader& input) {
-    static const JsonGroup errVal;
     if (!input.isValid())
-        return errVal;
+        return JsonGroup(input.getArena());
 
     const JsonSourceInfo info = {input.getFilename(), input.currentLine()};
 
     if (input.peekNextSymbol() != '{') {
         input.error() << "Unexpected symbol '" << input.peekNextSymbol() << " expected '{'" << std::endl;
-        return errVal;
+        return JsonGroup(input.getArena());
     }
     input.skipSymbol();
 
-    JsonGroup ret;
+    JsonGroup ret(input.getArena());
     ret.source = info;
 
     while (input.peekNextSymbol() == '"') {
         JsonField field = JsonField::load(input);
         if (!input.isValid())
-            return errVal;
-        ret.addField(field.getName(), field);
+            return JsonGroup(input.getArena());
+        ret.addField(std::move(field));
         if (input.peekNextSymbol() == ',')
             input.skipSymbol(); //trailing comma ok
     }
 
     if (input.peekNextSymbol() != '}') {
         input.error() << "Expected '}' got '" << input.peekNextSymbol() << '\'' << std::endl;
-        return errVal;
+        return JsonGroup(input.getArena());
     }
     input.skipSymbol();
 
@@ -175,32 +255,31 @@ JsonGroup JsonGroup::load(JsonLoader& input) {
 }
 
 JsonList JsonListUtil::load(JsonLoader& input) {
-    static const JsonList errVal;
     if (!input.isValid())
-        return errVal;
+        return JsonList(input.getArena());
 
     if (input.peekNextSymbol() != '[') {
         input.error() << "Expected '[' got '" << input.peekNextSymbol() << '\'' << std::endl;
-        return errVal;
+        return JsonList(input.getArena());
     }
     input.skipSymbol();
 
-    JsonList ret;
+    JsonList ret(input.getArena());
     while (input.peekNextSymbol() != ']') {
         if (!input.isValid()) {
             input.error() << "Unexpected end of file" << std::endl;
-            return errVal;
+            return JsonList(input.getArena());
         }
 
         JsonValue value = JsonValue::load(input);
         if (!input.isValid())
-            return errVal;
-        ret.push_back(value);
+            return JsonList(input.getArena());
+        ret.push_back(std::move(value));
 
         if (ret.size() > 1) {
             if (ret[ret.size()-1].getType() != ret[ret.size()-2].getType()) {
                 input.error() << "Types in list must all be the same" << std::endl;
-                return errVal;
+                return JsonList(input.getArena());
             }
         }
 
@@ -213,9 +292,8 @@ JsonList JsonListUtil::load(JsonLoader& input) {
 }
 
 JsonValue JsonValue::load(JsonLoader& input) {
-    static const JsonValue errVal;
     if (!input.isValid())
-        return errVal;
+        return JsonValue();
 
     const JsonSourceInfo info = {input.getFilename(), input.currentLine()};
 
@@ -226,10 +304,10 @@ JsonValue JsonValue::load(JsonLoader& input) {
             value.source = info;
             return value;
         }
-        return errVal;
+        return JsonValue();
     }
     if (input.peekNextSymbol() == '"') {
-        JsonValue value(input.loadString());
+        JsonValue value(input.copyToArena(input.loadStringView()));
         value.source = info;
         return value;
     }
@@ -239,49 +317,46 @@ JsonValue JsonValue::load(JsonLoader& input) {
         return value;
     }
     if (input.peekNextSymbol() == '{') {
-        const JsonGroup group = JsonGroup::load(input);
+        JsonGroup group = JsonGroup::load(input);
         if (!input.isValid())
-            return errVal;
-        JsonValue value(group);
+            return JsonValue();
+        JsonValue value(std::move(group));
         value.source = info;
         return value;
     }
     if (input.peekNextSymbol() == '[') {
-        const JsonList list = JsonListUtil::load(input);
+        JsonList list = JsonListUtil::load(input);
         if (!input.isValid())
-            return errVal;
-        JsonValue value(list);
+            return JsonValue();
+        JsonValue value(std::move(list));
         value.source = info;
         return value;
     }
 
     input.error() << "Unexpected symbol '" << input.peekNextSymbol() << "' expected Value" << std::endl;
-    return errVal;
+    return JsonValue();
 }
 
 JsonField JsonField::load(JsonLoader& input) {
-    static const JsonField errVal;
     if (!input.isValid())
-        return errVal;
+        return JsonField();
 
     const JsonSourceInfo info = {input.getFilename(), input.currentLine()};
 
     if (input.peekNextSymbol() != '"') {
         input.error() << "Expected '\"'" << std::endl;
-        return errVal;
+        return JsonField();
     }
-    const std::string name = input.loadString();
+    const JsonKey name = JsonKey::intern(input.loadStringView());
 
     if (input.peekNextSymbol() != ':') {
         input.error() << "Expecting ':'" << std::endl;
     }
     input.skipSymbol();
     if (!input.isValid())
-        return errVal;
+        return JsonField();
         
-    const JsonValue value = JsonValue::load(input);
-
-    JsonField ret(name, value);
+    JsonField ret(name, JsonValue::load(input));
     ret.source = info;
     return ret;
 }
\ No newline at end of file
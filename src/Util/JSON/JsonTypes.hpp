@@ -2,10 +2,11 @@
 #define JSONTYPES_HPP
 
 #include <vector>
-#include <map>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <ostream>
+#include <memory_resource>
 
 class JsonField;
 class JsonValue;
@@ -13,49 +14,108 @@ class JsonGroup;
 class JsonLoader;
 
 /**
- * Helper struct for json source info
+ * Interned string used for field names and filenames. Every unique string is stored once for the
+ * lifetime of the program along with its hash, so keys repeated throughout a large file cost a
+ * single pointer each and compare by identity
+ */
+class JsonKey {
+public:
+    /**
+     * Creates the empty key
+     */
+    JsonKey();
+
+    /**
+     * Returns the key for the given string, creating it if this is its first use
+     */
+    static JsonKey intern(std::string_view str);
+
+    /**
+     * Hash function used for keys. Exposed so that lookups can be hashed ahead of time
+     */
+    static std::size_t hash(std::string_view str);
+
+    const std::string& str() const { return entry->value; }
+    std::size_t hash() const { return entry->hash; }
+    operator std::string_view() const { return entry->value; }
+
+    bool operator==(const JsonKey& key) const { return entry == key.entry; }
+    bool operator!=(const JsonKey& key) const { return entry != key.entry; }
+
+private:
+    struct Entry {
+        const std::string value;
+        const std::size_t hash;
+    };
+
+    const Entry* entry;
+
+    JsonKey(const Entry* entry) : entry(entry) {}
+};
+
+/**
+ * Helper struct for json source info. The filename refers to interned storage
  */
 struct JsonSourceInfo {
-    std::string filename;
-    int lineNumber;
+    std::string_view filename;
+    int lineNumber = 0;
 };
 
 std::ostream& operator<<(std::ostream& stream, const JsonSourceInfo& info);
 
 /**
- * List of JsonValue objects
+ * List of JsonValue objects. Storage comes from the arena of the file it was loaded from
  */
-typedef std::vector<JsonValue> JsonList;
+typedef std::pmr::vector<JsonValue> JsonList;
 struct JsonListUtil {
     static JsonList load(JsonLoader& input);
     static void print(const JsonList& list, std::ostream& stream, int indentLevel = 4);
 };
 
 /**
- * Represents a collection of named JsonField objects
+ * Represents a collection of named JsonField objects. Fields are stored flat in declaration order
+ * with a sorted index over them for lookup by name
  */
 class JsonGroup {
 public:
-    JsonGroup() {}
+    explicit JsonGroup(std::pmr::memory_resource* arena = std::pmr::get_default_resource());
+    JsonGroup(JsonGroup&&) = default;
+    JsonGroup& operator=(JsonGroup&&) = default;
 
-    void addField(const std::string& name, const JsonField& field);
-    bool hasField(const std::string& name) const;
-    const JsonValue* getField(const std::string& name) const;
+    void addField(JsonField&& field);
+    bool hasField(std::string_view name) const;
+    const JsonValue* getField(std::string_view name) const;
     const std::vector<std::string> getFields() const;
-    
+
+    /**
+     * Returns the number of fields in the group
+     */
+    std::size_t fieldCount() const { return fields.size(); }
+
+    /**
+     * Returns the field at the given index in declaration order
+     */
+    const JsonField& fieldAt(std::size_t i) const { return fields[i]; }
+
     const JsonSourceInfo& info() const { return source; }
 
     void print(std::ostream& stream, int indentLevel) const;
     static JsonGroup load(JsonLoader& input);
 
 private:
-    std::vector<std::string> fieldNames;
-    std::map<std::string, JsonField> fields;
+    std::pmr::vector<JsonField> fields;
+    std::pmr::vector<unsigned int> sorted;
     JsonSourceInfo source;
+
+    JsonGroup(const JsonGroup&) = delete;
+    JsonGroup& operator=(const JsonGroup&) = delete;
+
+    std::pmr::vector<unsigned int>::const_iterator find(std::string_view name) const;
 };
 
 /**
- * Represents a Value in json. Can be numeric, string, list of values, or group of fields
+ * Represents a Value in json. Can be numeric, string, list of values, or group of fields. Values
+ * are move only. String data is owned by the arena the value was loaded into
  */
 class JsonValue {
 public:
@@ -71,13 +131,15 @@ public:
     JsonValue() : type(Unknown) {}
     JsonValue(bool value);
     JsonValue(float value);
-    JsonValue(const std::string& value);
-    JsonValue(const JsonList& value);
-    JsonValue(const JsonGroup& value);
+    JsonValue(std::string_view value);
+    JsonValue(JsonList&& value);
+    JsonValue(JsonGroup&& value);
+    JsonValue(JsonValue&&) = default;
+    JsonValue& operator=(JsonValue&&) = default;
 
     Type getType() const;
     const bool* getAsBool() const;
-    const std::string* getAsString() const;
+    const std::string_view* getAsString() const;
     const float* getAsNumeric() const;
     const JsonList* getAsList() const;
     const JsonGroup* getAsGroup() const;
@@ -88,9 +150,12 @@ public:
     void print(std::ostream& stream, int indentLevel = 4) const;
 
 private:
-    const Type type;
-    const std::variant<bool, std::string, float, JsonGroup, JsonList> data;
+    Type type;
+    std::variant<bool, std::string_view, float, JsonGroup, JsonList> data;
     JsonSourceInfo source;
+
+    JsonValue(const JsonValue&) = delete;
+    JsonValue& operator=(const JsonValue&) = delete;
 };
 
 std::ostream& operator<<(std::ostream& stream, const JsonValue::Type& type);
@@ -101,10 +166,13 @@ std::ostream& operator<<(std::ostream& stream, const JsonValue::Type& type);
 class JsonField {
 public:
     JsonField() {}
-    JsonField(const std::string& name, const JsonValue& value)
-        : name(name), value(value) {}
+    JsonField(JsonKey name, JsonValue&& value)
+        : name(name), value(std::move(value)) {}
+    JsonField(JsonField&&) = default;
+    JsonField& operator=(JsonField&&) = default;
 
-    const std::string& getName() const { return name; }
+    const std::string& getName() const { return name.str(); }
+    JsonKey getKey() const { return name; }
     const JsonValue& getValue() const { return value; }
 
     const JsonSourceInfo& info() const { return source; }
@@ -114,8 +182,11 @@ public:
 
 private:
     JsonSourceInfo source;
-    const std::string name;
-    const JsonValue value;
+    JsonKey name;
+    JsonValue value;
+
+    JsonField(const JsonField&) = delete;
+    JsonField& operator=(const JsonField&) = delete;
 };
 
 #endif
\ No newline at end of file
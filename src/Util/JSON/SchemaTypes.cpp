@@ -17,15 +17,6 @@ std::ostream& error(const JsonSourceInfo& info) {
 }
 }
 
-struct SchemaGroup::Field {
-    const std::string name;
-    const SchemaValue value;
-    const bool required;
-
-    Field(const std::string& name, const SchemaValue& value, bool required)
-        : name(name), value(value), required(required) {}
-};
-
 SchemaGroup::SchemaGroup(bool overrideStrict, bool isStrict)
 : overrideStrict(overrideStrict), isStrict(isStrict) {}
 
@@ -159,7 +150,7 @@ bool SchemaValue::validate(const JsonValue& value, bool strict) const {
     case JsonValue::Numeric: {
             const float* val = value.getAsNumeric();
             if (val) {
-                auto limits = *std::get_if<std::pair<std::optional<float>, std::optional<float> > >(data.get());
+                const auto& limits = *std::get_if<std::pair<std::optional<float>, std::optional<float> > >(data.get());
                 if (*val < limits.first.value_or((*val) - 1)) {
                     error(value.info()) << "Numeric JsonValue is too low. Min: " << limits.first.value() << std::endl;
                     return false;
@@ -177,9 +168,9 @@ bool SchemaValue::validate(const JsonValue& value, bool strict) const {
         break;
 
     case JsonValue::String: {
-            const std::string* val = value.getAsString();
+            const std::string_view* val = value.getAsString();
             if (val) {
-                auto values = *std::get_if<std::list<std::string> >(data.get());
+                const auto& values = *std::get_if<std::list<std::string> >(data.get());
                 if (values.size() > 0) {
                     if (std::find(values.begin(), values.end(), *val) == values.end()) {
                         error(value.info()) << '"' << *val << "' is not a valid String value. Must be in [";
@@ -2,6 +2,7 @@
 #define SCHEMATYPES_HPP
 
 #include <Util/JSON/JsonTypes.hpp>
+#include <map>
 #include <memory>
 #include <optional>
 #include <list>
@@ -72,6 +73,8 @@ private:
 
     const JsonValue::Type type;
     std::shared_ptr<const TData> data;
+
+    friend class CompiledSchema;
 };
 
 /**
@@ -100,11 +103,20 @@ public:
     bool validate(const JsonGroup& data, bool strict) const;
 
 private:
-    struct Field;
+    struct Field {
+        const std::string name;
+        const SchemaValue value;
+        const bool required;
+
+        Field(const std::string& name, const SchemaValue& value, bool required)
+            : name(name), value(value), required(required) {}
+    };
 
     const bool overrideStrict;
     const bool isStrict;
     std::vector<std::shared_ptr<Field> > schema;
+
+    friend class CompiledSchema;
 };
 
 /**
@@ -121,6 +133,8 @@ public:
 private:
     const unsigned int nRequiredFields;
     std::map<std::string, SchemaValue> fieldOptions;
+
+    friend class CompiledSchema;
 };
 
 #endif
\ No newline at end of file
@@ -3,12 +3,26 @@
 #include <fstream>
 #include <Util/JSON/JsonLoader.hpp>
 
-JsonFile::JsonFile(const JsonGroup& root)
-: root(root) {}
+namespace {
+// Rough ratio of DOM memory to source text. Sized so typical files fit in the first block
+constexpr std::size_t arenaSizeFactor = 4;
+constexpr std::size_t minArenaSize = 4096;
+}
+
+JsonFile::JsonFile(JsonGroup&& root)
+: root(std::move(root)) {}
+
+JsonFile::JsonFile(const std::string& filename)
+: root(load(filename, arena)) {}
 
-JsonFile::JsonFile(const std::string& filename) {
+JsonGroup JsonFile::load(const std::string& filename, std::unique_ptr<std::pmr::monotonic_buffer_resource>& arena) {
     JsonLoader file(filename);
-    root = JsonGroup::load(file);
+    arena.reset(new std::pmr::monotonic_buffer_resource(
+        std::max(file.inputSize() * arenaSizeFactor, minArenaSize),
+        std::pmr::new_delete_resource()
+    ));
+    file.setArena(arena.get());
+    return JsonGroup::load(file);
 }
 
 void JsonFile::save(const std::string& filename) const {
@@ -2,17 +2,20 @@
 #define JSONFILE_HPP
 
 #include <Util/JSON/JsonTypes.hpp>
+#include <memory>
+#include <memory_resource>
 #include <ostream>
 
 /**
- * Utility class to load and save json files. Can optionally verify a schema
+ * Utility class to load and save json files. Can optionally verify a schema. Loaded files own the
+ * arena that all of their values are allocated from, so the data must not outlive the file
  */
 class JsonFile {
 public:
     /**
      * Creates a file from the root data
      */
-    JsonFile(const JsonGroup& root);
+    JsonFile(JsonGroup&& root);
 
     /**
      * Loads the json data from the given file
@@ -35,7 +38,13 @@ public:
     const JsonGroup& getRoot() const;
 
 private:
-    JsonGroup root;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+    JsonGroup root; // after the arena, it is moved in whole so that it keeps the arena allocator
+
+    /**
+     * Creates the arena and loads the file into it
+     */
+    static JsonGroup load(const std::string& file, std::unique_ptr<std::pmr::monotonic_buffer_resource>& arena);
 };
 
 #endif
\ No newline at end of file
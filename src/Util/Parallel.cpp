@@ -0,0 +1,33 @@
+#include <Util/Parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <SFML/System.hpp>
+
+void parallelFor(unsigned int count, const std::function<void(unsigned int)>& task) {
+    const unsigned int nThreads = std::min(count, std::max(std::thread::hardware_concurrency(), 1u));
+    if (nThreads <= 1) {
+        for (unsigned int i = 0; i < count; ++i)
+            task(i);
+        return;
+    }
+
+    std::atomic<unsigned int> next(0);
+    auto worker = [&next, &task, count]() {
+        for (unsigned int i = next++; i < count; i = next++)
+            task(i);
+    };
+
+    std::vector<std::unique_ptr<sf::Thread> > threads;
+    threads.reserve(nThreads - 1);
+    for (unsigned int i = 1; i < nThreads; ++i) {
+        threads.emplace_back(new sf::Thread(worker));
+        threads.back()->launch();
+    }
+    worker();
+    for (std::unique_ptr<sf::Thread>& thread : threads)
+        thread->wait();
+}
@@ -0,0 +1,13 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <functional>
+
+/**
+ * Runs task(i) for every i in [0, count) across worker threads and returns once all have finished.
+ * The calling thread takes part. Tasks must be independent of each other. Threads are started per
+ * call, so this is meant for bursts of work rather than per frame use
+ */
+void parallelFor(unsigned int count, const std::function<void(unsigned int)>& task);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <Util/Profiler.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+constexpr float Smoothing = 0.05f;
+constexpr unsigned int OverlaySize = 14;
+
+/**
+ * Writes the string as a quoted JSON string
+ */
+void writeJsonString(std::ostream& output, const std::string& str) {
+    output << '"';
+    for (char ch : str) {
+        switch (ch) {
+        case '"':
+            output << "\\\"";
+            break;
+        case '\\':
+            output << "\\\\";
+            break;
+        case '\n':
+            output << "\\n";
+            break;
+        case '\t':
+            output << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20) {
+                output << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                       << static_cast<int>(ch) << std::dec << std::setfill(' ');
+            }
+            else
+                output << ch;
+        }
+    }
+    output << '"';
+}
+}
+
+Profiler::Scope::Scope(unsigned int zone)
+: zone(zone)
+, active(Profiler::get().enabled && Profiler::get().isMainThread())
+, start(active ? Profiler::get().now() : 0) {
+    if (active)
+        Profiler::get().depth += 1;
+}
+
+Profiler::Scope::~Scope() {
+    if (active)
+        Profiler::get().record(zone, start);
+}
+
+Profiler::Profiler()
+: mainThread(std::this_thread::get_id())
+, enabled(true)
+, depth(0)
+, events(Capacity)
+, nextEvent(0)
+, wrapped(false)
+, frameStart(0)
+, frameAverage(0) {}
+
+Profiler& Profiler::get() {
+    static Profiler profiler;
+    return profiler;
+}
+
+unsigned int Profiler::zone(const std::string& name) {
+    sf::Lock lock(zoneLock);
+    for (unsigned int i = 0; i<zones.size(); ++i) {
+        if (zones[i].name == name)
+            return i;
+    }
+    zones.push_back({name, 0, 0});
+    return zones.size() - 1;
+}
+
+void Profiler::setCounter(const std::string& name, float value) {
+    for (std::pair<std::string, float>& counter : counters) {
+        if (counter.first == name) {
+            counter.second = value;
+            return;
+        }
+    }
+    counters.emplace_back(name, value);
+}
+
+void Profiler::setEnabled(bool e) {
+    enabled = e;
+}
+
+bool Profiler::isEnabled() const {
+    return enabled;
+}
+
+std::int64_t Profiler::now() const {
+    return clock.getElapsedTime().asMicroseconds();
+}
+
+bool Profiler::isMainThread() const {
+    return std::this_thread::get_id() == mainThread;
+}
+
+void Profiler::record(unsigned int zone, std::int64_t start) {
+    depth -= 1;
+    const std::int64_t duration = now() - start;
+
+    {
+        // Zones may be declared from other threads, which can move the vector
+        sf::Lock lock(zoneLock);
+        zones[zone].frameTotal += duration;
+    }
+
+    events[nextEvent] = {zone, depth, start, duration};
+    nextEvent += 1;
+    if (nextEvent == Capacity) {
+        nextEvent = 0;
+        wrapped = true;
+    }
+}
+
+void Profiler::endFrame() {
+    const std::int64_t end = now();
+    const float frameMs = (end - frameStart) / 1000.0f;
+    frameStart = end;
+    frameAverage += (frameMs - frameAverage) * Smoothing;
+
+    sf::Lock lock(zoneLock);
+    for (Zone& zone : zones) {
+        zone.average += (zone.frameTotal / 1000.0f - zone.average) * Smoothing;
+        zone.frameTotal = 0;
+    }
+}
+
+void Profiler::renderOverlay(sf::RenderTarget& target, const sf::Font& font) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "Frame: " << frameAverage << " ms\n";
+    {
+        sf::Lock lock(zoneLock);
+        for (const Zone& zone : zones)
+            ss << zone.name << ": " << zone.average << " ms\n";
+    }
+    ss << std::setprecision(0);
+    for (const std::pair<std::string, float>& counter : counters)
+        ss << counter.first << ": " << counter.second << "\n";
+
+    sf::Text text;
+    text.setFont(font);
+    text.setCharacterSize(OverlaySize);
+    text.setFillColor(sf::Color::White);
+    text.setOutlineColor(sf::Color::Black);
+    text.setOutlineThickness(1);
+    text.setPosition({10, 40});
+    text.setString(ss.str());
+
+    const sf::View view = target.getView();
+    target.setView(target.getDefaultView());
+    target.draw(text);
+    target.setView(view);
+}
+
+template<typename F>
+void Profiler::forEachEvent(F callback) const {
+    if (wrapped) {
+        for (unsigned int i = nextEvent; i<Capacity; ++i)
+            callback(events[i]);
+    }
+    for (unsigned int i = 0; i<nextEvent; ++i)
+        callback(events[i]);
+}
+
+bool Profiler::exportCsv(const std::string& file) const {
+    std::ofstream output(file.c_str());
+    if (!output.good()) {
+        std::cerr << "Failed to open profile output file: " << file << std::endl;
+        return false;
+    }
+
+    sf::Lock lock(zoneLock);
+    output << "zone,depth,start_us,duration_us\n";
+    forEachEvent([this, &output](const Event& event) {
+        output << zones[event.zone].name << ',' << event.depth << ',' << event.start << ','
+               << event.duration << '\n';
+    });
+    return output.good();
+}
+
+bool Profiler::exportChromeTrace(const std::string& file) const {
+    std::ofstream output(file.c_str());
+    if (!output.good()) {
+        std::cerr << "Failed to open profile output file: " << file << std::endl;
+        return false;
+    }
+
+    sf::Lock lock(zoneLock);
+    bool first = true;
+    output << "{\"traceEvents\":[\n";
+    forEachEvent([this, &output, &first](const Event& event) {
+        if (!first)
+            output << ",\n";
+        first = false;
+        output << "{\"name\":";
+        writeJsonString(output, zones[event.zone].name);
+        output << ",\"ph\":\"X\",\"ts\":" << event.start
+               << ",\"dur\":" << event.duration << ",\"pid\":0,\"tid\":0}";
+    });
+    output << "\n]}\n";
+    return output.good();
+}
@@ -0,0 +1,138 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+/**
+ * Scoped hot path profiler. Zones are timed with RAII Scope objects, normally through the
+ * PROFILE_ZONE macro, and recorded into a fixed size ring buffer that overwrites the oldest events.
+ * Per zone totals are kept for each frame and smoothed for the on-screen overlay. The buffer can be
+ * exported as CSV or as a Chrome trace (load in chrome://tracing or Perfetto)
+ *
+ * Only records from the main thread. Scopes entered on other threads are ignored. Zones may be
+ * declared from any thread
+ *
+ * \ingroup Util
+ */
+class Profiler {
+public:
+    /**
+     * Times the enclosing scope
+     */
+    class Scope {
+    public:
+        explicit Scope(unsigned int zone);
+        ~Scope();
+
+    private:
+        const unsigned int zone;
+        const bool active;
+        const std::int64_t start;
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * Returns the global profiler
+     */
+    static Profiler& get();
+
+    /**
+     * Returns the id of the zone with the given name, creating it on first use
+     */
+    unsigned int zone(const std::string& name);
+
+    /**
+     * Enables or disables recording. Disabled scopes cost a couple of branches
+     */
+    void setEnabled(bool enabled);
+
+    /**
+     * Returns whether or not recording is enabled
+     */
+    bool isEnabled() const;
+
+    /**
+     * Sets a named per frame value to show in the overlay, such as a draw call count
+     */
+    void setCounter(const std::string& name, float value);
+
+    /**
+     * Marks the end of a frame. Updates the smoothed zone times shown in the overlay
+     */
+    void endFrame();
+
+    /**
+     * Renders per zone milliseconds, averaged over recent frames, and the counters in the top left
+     * of the target
+     */
+    void renderOverlay(sf::RenderTarget& target, const sf::Font& font);
+
+    /**
+     * Writes the recorded events as CSV: zone, depth, start and duration in microseconds
+     */
+    bool exportCsv(const std::string& file) const;
+
+    /**
+     * Writes the recorded events in the Chrome trace event format
+     */
+    bool exportChromeTrace(const std::string& file) const;
+
+private:
+    struct Event {
+        unsigned int zone;
+        unsigned int depth;
+        std::int64_t start;
+        std::int64_t duration;
+    };
+
+    struct Zone {
+        std::string name;
+        std::int64_t frameTotal;
+        float average; // ms
+    };
+
+    static constexpr unsigned int Capacity = 1 << 16;
+
+    sf::Clock clock;
+    const std::thread::id mainThread;
+    mutable sf::Mutex zoneLock;
+    bool enabled;
+    unsigned int depth;
+    std::vector<Zone> zones;
+    std::vector<std::pair<std::string, float> > counters;
+    std::vector<Event> events;
+    unsigned int nextEvent;
+    bool wrapped;
+    std::int64_t frameStart;
+    float frameAverage; // ms
+
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    std::int64_t now() const;
+    void record(unsigned int zone, std::int64_t start);
+    bool isMainThread() const;
+
+    template<typename F>
+    void forEachEvent(F callback) const;
+};
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+/**
+ * Times the rest of the enclosing scope as the named zone
+ */
+#define PROFILE_ZONE(name)                                                                        \
+    static const unsigned int PROFILE_CONCAT(profileZone, __LINE__) = Profiler::get().zone(name); \
+    const Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(PROFILE_CONCAT(profileZone, __LINE__))
+
+#endif
\ No newline at end of file
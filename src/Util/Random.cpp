@@ -0,0 +1,111 @@
+#include <Util/Random.hpp>
+
+#include <atomic>
+#include <random>
+#include <utility>
+
+namespace {
+std::uint64_t makeSeed() {
+    std::random_device device;
+    return (static_cast<std::uint64_t>(device()) << 32) | device();
+}
+
+std::atomic<std::uint64_t> globalSeed(makeSeed());
+std::atomic<std::uint64_t> nextThreadStream(0);
+std::atomic<std::uint64_t> seedGeneration(0);
+
+/**
+ * Thread generator along with the seed generation it was last seeded for
+ */
+struct LocalRandom {
+    Random rng = Random(0);
+    std::uint64_t generation = ~0ull;
+};
+
+std::uint64_t splitMix(std::uint64_t& x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline std::uint32_t rotl(std::uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+}
+
+Random::Random(std::uint64_t s, std::uint64_t stream) {
+    seed(s, stream);
+}
+
+Random& Random::local() {
+    // Reseed on the first use after each setSeed() so that generators used before it do not
+    // keep their old sequence or stream
+    thread_local LocalRandom local;
+    const std::uint64_t generation = seedGeneration.load();
+    if (local.generation != generation) {
+        local.rng.seed(globalSeed.load(), nextThreadStream++);
+        local.generation = generation;
+    }
+    return local.rng;
+}
+
+void Random::setSeed(std::uint64_t seed) {
+    globalSeed = seed;
+    nextThreadStream = 0;
+    ++seedGeneration;
+    // The calling thread always takes stream 0
+    local();
+}
+
+std::uint64_t Random::getSeed() {
+    return globalSeed.load();
+}
+
+void Random::seed(std::uint64_t seed, std::uint64_t stream) {
+    // Mix the stream into the seed so that nearby seeds and streams give unrelated states
+    std::uint64_t x = seed;
+    x = splitMix(x) ^ stream;
+    const std::uint64_t a = splitMix(x);
+    const std::uint64_t b = splitMix(x);
+    state[0] = a;
+    state[1] = a >> 32;
+    state[2] = b;
+    state[3] = b >> 32;
+    if ((state[0] | state[1] | state[2] | state[3]) == 0)
+        state[0] = 1;
+}
+
+std::uint32_t Random::next() {
+    const std::uint32_t result = rotl(state[1] * 5, 7) * 9;
+    const std::uint32_t t = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 11);
+
+    return result;
+}
+
+int Random::nextInt(int mn, int mx) {
+    if (mn > mx)
+        std::swap(mn, mx);
+
+    // Multiply and shift to map onto the range without division
+    const std::uint64_t range = static_cast<std::uint64_t>(static_cast<std::int64_t>(mx) - mn) + 1;
+    const std::uint64_t offset = (next() * range) >> 32;
+    return static_cast<int>(mn + static_cast<std::int64_t>(offset));
+}
+
+void Random::fill(float* output, std::size_t count, float mn, float mx) {
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = nextFloat(mn, mx);
+}
+
+void Random::fill(std::uint32_t* output, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        output[i] = next();
+}
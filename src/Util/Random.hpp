@@ -0,0 +1,89 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Small, fast pseudo random number generator (xoshiro128**). Generators are cheap to create and
+ * copy, so code that wants reproducible or parallel output should create its own from a seed and
+ * stream id rather than share one. Not thread safe, each thread should use its own generator
+ *
+ * Random::local() returns a generator owned by the calling thread. Each thread's generator is
+ * seeded from the global seed and a stream id. Stream ids restart whenever the seed is set: the
+ * thread setting it takes stream 0 and other threads take the next ids in the order they first
+ * use their generator afterwards
+ */
+class Random {
+public:
+    /**
+     * Creates a generator from the given seed. Generators with the same seed and different streams
+     * produce independent sequences
+     *
+     * \param seed The seed to start from
+     * \param stream Stream id to derive the sequence for
+     */
+    explicit Random(std::uint64_t seed, std::uint64_t stream = 0);
+
+    /**
+     * Returns the generator for the calling thread
+     */
+    static Random& local();
+
+    /**
+     * Sets the global seed and reseeds the calling thread's generator with stream 0. Every other
+     * thread's generator is reseeded the next time that thread uses it. Must not be called while
+     * other threads are drawing from their generators
+     */
+    static void setSeed(std::uint64_t seed);
+
+    /**
+     * Returns the global seed. Defaults to a non-deterministic value
+     */
+    static std::uint64_t getSeed();
+
+    /**
+     * Restarts this generator from the given seed and stream
+     */
+    void seed(std::uint64_t seed, std::uint64_t stream = 0);
+
+    /**
+     * Returns 32 random bits
+     */
+    std::uint32_t next();
+
+    /**
+     * Returns a float in [0, 1)
+     */
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+
+    /**
+     * Returns a float in [mn, mx)
+     */
+    float nextFloat(float mn, float mx) { return mn + nextFloat() * (mx - mn); }
+
+    /**
+     * Returns an int in [mn, mx]
+     */
+    int nextInt(int mn, int mx);
+
+    /**
+     * Returns true with the given probability
+     */
+    bool chance(float probability) { return nextFloat() < probability; }
+
+    /**
+     * Fills the array with floats in [mn, mx)
+     */
+    void fill(float* output, std::size_t count, float mn, float mx);
+
+    /**
+     * Fills the array with random bits
+     */
+    void fill(std::uint32_t* output, std::size_t count);
+
+private:
+    std::uint32_t state[4];
+};
+
+#endif
\ No newline at end of file
@@ -119,6 +119,28 @@ public:
         return temp;
     }
 
+    /**
+     * Reloads the resource at the given URI in place if it is loaded. Everything holding the
+     * resource sees the new data. Resources that are not loaded are ignored
+     *
+     * \param uri The path to the resource to reload
+     * \return True if the resource was loaded and has been reloaded
+     */
+    bool reloadResource(std::string uri)
+    {
+        lock.lock();
+        auto i = resources.find(uri);
+        if (i==resources.end())
+        {
+            lock.unlock();
+            return false;
+        }
+        std::unique_ptr<T> temp(loadResourceFromUri<T>(uri));
+        *i->second = std::move(*temp);
+        lock.unlock();
+        return true;
+    }
+
     /**
      * Frees all resources, regardless of what may still be using them
      */
@@ -2,127 +2,113 @@
 
 namespace {
 
-JsonSchema createBackgroundSchema() {
+typedef BackgroundElementSpec Element;
+
+JsonBinding<BackgroundSpec> createBackgroundBinding() {
     // Generic range
-    SchemaGroup rangeGroup;
-    rangeGroup.addOptionalField("preserveAR", SchemaValue::anyBool);
-    rangeGroup.addOptionalField("allowHFlip", SchemaValue::anyBool);
-    rangeGroup.addOptionalField("allowVFlip", SchemaValue::anyBool);
-    rangeGroup.addExpectedField("minx", SchemaValue::positiveNumber);
-    rangeGroup.addExpectedField("miny", SchemaValue::positiveNumber);
-    rangeGroup.addExpectedField("maxx", SchemaValue::positiveNumber);
-    rangeGroup.addExpectedField("maxy", SchemaValue::positiveNumber);
-    SchemaValue rangeValue(rangeGroup);
+    JsonBinding<Element::Range> rangeGroup;
+    rangeGroup.optional("preserveAR", &Element::Range::preserveAR, SchemaValue::anyBool);
+    rangeGroup.optional("allowHFlip", &Element::Range::allowHFlip, SchemaValue::anyBool);
+    rangeGroup.optional("allowVFlip", &Element::Range::allowVFlip, SchemaValue::anyBool);
+    rangeGroup.expect("minx", &Element::Range::minx, SchemaValue::positiveNumber);
+    rangeGroup.expect("miny", &Element::Range::miny, SchemaValue::positiveNumber);
+    rangeGroup.expect("maxx", &Element::Range::maxx, SchemaValue::positiveNumber);
+    rangeGroup.expect("maxy", &Element::Range::maxy, SchemaValue::positiveNumber);
 
     // Image scale
-    SchemaGroup fixedScale;
-    fixedScale.addExpectedField("x", SchemaValue::anyNumber);
-    fixedScale.addExpectedField("y", SchemaValue::anyNumber);
-    SchemaUnion imageScale;
-    imageScale.addFieldOption("fixed", SchemaValue(fixedScale));
-    imageScale.addFieldOption("ranged", rangeValue);
-    SchemaValue imageScaleValue(imageScale);
+    JsonBinding<Element::Pair> fixedScale;
+    fixedScale.expect("x", &Element::Pair::x, SchemaValue::anyNumber);
+    fixedScale.expect("y", &Element::Pair::y, SchemaValue::anyNumber);
+    JsonBinding<Element::Scale> imageScale;
+    imageScale.option("fixed", &Element::Scale::fixed, fixedScale);
+    imageScale.option("ranged", &Element::Scale::ranged, rangeGroup);
+    imageScale.makeUnion();
 
     // Image positioning
-    SchemaGroup randomPosGroup;
-    randomPosGroup.addExpectedField("density", SchemaValue(0, 1));
-    SchemaUnion imagePosUnion;
-    imagePosUnion.addFieldOption("random", SchemaValue(randomPosGroup));
-    imagePosUnion.addFieldOption("fixedSpacing", SchemaValue(fixedScale));
-    imagePosUnion.addFieldOption("rangedSpacing", rangeValue);
-    SchemaValue imagePosValue(imagePosUnion);
+    JsonBinding<Element::Random> randomPosGroup;
+    randomPosGroup.expect("density", &Element::Random::density, SchemaValue(0, 1));
+    JsonBinding<Element::Positioning> imagePosUnion;
+    imagePosUnion.option("random", &Element::Positioning::random, randomPosGroup);
+    imagePosUnion.option("fixedSpacing", &Element::Positioning::fixedSpacing, fixedScale);
+    imagePosUnion.option("rangedSpacing", &Element::Positioning::rangedSpacing, rangeGroup);
+    imagePosUnion.makeUnion();
 
     // Image
-    SchemaGroup imageGroup;
-    imageGroup.addExpectedField("file", SchemaValue::anyString);
-    imageGroup.addExpectedField("positioning", imagePosValue);
-    imageGroup.addExpectedField("scale", imageScaleValue);
-    SchemaValue imageValue(imageGroup);
-
-    // Image list
-    SchemaList imageList(imageValue);
-    SchemaValue imageListValue(imageList);
+    JsonBinding<Element> imageGroup;
+    imageGroup.expect("file", &Element::file, SchemaValue::anyString);
+    imageGroup.expect("positioning", &Element::positioning, imagePosUnion);
+    imageGroup.expect("scale", &Element::scale, imageScale);
 
     // Color
     SchemaValue colorNumber(0, 255);
-    SchemaGroup colorGroup;
-    colorGroup.addExpectedField("red", colorNumber);
-    colorGroup.addExpectedField("green", colorNumber);
-    colorGroup.addExpectedField("blue", colorNumber);
-    SchemaValue colorValue(colorGroup);
+    JsonBinding<BackgroundSpec::Color> colorGroup;
+    colorGroup.expect("red", &BackgroundSpec::Color::red, colorNumber);
+    colorGroup.expect("green", &BackgroundSpec::Color::green, colorNumber);
+    colorGroup.expect("blue", &BackgroundSpec::Color::blue, colorNumber);
 
     // Base group
-    SchemaGroup backgroundGroup;
-    backgroundGroup.addExpectedField("color", colorValue);
-    backgroundGroup.addExpectedField("elements", imageListValue);
-    
-    return JsonSchema(backgroundGroup);
-}
+    JsonBinding<BackgroundSpec> backgroundGroup;
+    backgroundGroup.expect("color", &BackgroundSpec::color, colorGroup);
+    backgroundGroup.expect("elements", &BackgroundSpec::elements, imageGroup);
 
-JsonSchema createEntitySchema() {
-    SchemaGroup entityGroup;
-    entityGroup.addExpectedField("name", SchemaValue::anyString);
-    entityGroup.addExpectedField("gfx", SchemaValue::anyString);
-    entityGroup.addExpectedField("x", SchemaValue::anyNumber);
-    entityGroup.addExpectedField("y", SchemaValue::anyNumber);
-    entityGroup.addExpectedField("vx", SchemaValue::anyNumber);
-    entityGroup.addExpectedField("vy", SchemaValue::anyNumber);
-    entityGroup.addExpectedField("mass", SchemaValue::positiveNumber);
-    entityGroup.addExpectedField("canMove", SchemaValue::anyBool);
-    entityGroup.addExpectedField("hasGravity", SchemaValue::anyBool);
-    entityGroup.addOptionalField("gravityRange", SchemaValue::positiveNumber);
-    
-    return JsonSchema(entityGroup);
+    return backgroundGroup;
 }
 
-JsonSchema createEnvironmentSchema() {
-    // Entity List
-    SchemaList entityList(SchemaValue(createEntitySchema().getRoot()));
-    SchemaValue entityListValue(entityList);
-
-    // Background 
-    SchemaValue backgroundValue(createBackgroundSchema().getRoot());
+JsonBinding<EntitySpec> createEntityBinding() {
+    JsonBinding<EntitySpec> entityGroup;
+    entityGroup.expect("name", &EntitySpec::name, SchemaValue::anyString);
+    entityGroup.expect("gfx", &EntitySpec::gfx, SchemaValue::anyString);
+    entityGroup.expect("x", &EntitySpec::x, SchemaValue::anyNumber);
+    entityGroup.expect("y", &EntitySpec::y, SchemaValue::anyNumber);
+    entityGroup.expect("vx", &EntitySpec::vx, SchemaValue::anyNumber);
+    entityGroup.expect("vy", &EntitySpec::vy, SchemaValue::anyNumber);
+    entityGroup.expect("mass", &EntitySpec::mass, SchemaValue::positiveNumber);
+    entityGroup.expect("canMove", &EntitySpec::canMove, SchemaValue::anyBool);
+    entityGroup.expect("hasGravity", &EntitySpec::hasGravity, SchemaValue::anyBool);
+    entityGroup.optional("gravityRange", &EntitySpec::gravityRange, SchemaValue::positiveNumber);
+
+    return entityGroup;
+}
 
+JsonBinding<EnvironmentSpec> createEnvironmentBinding() {
     // Player Spawn
-    SchemaGroup spawnGroup;
-    spawnGroup.addExpectedField("x", SchemaValue::anyNumber);
-    spawnGroup.addExpectedField("y", SchemaValue::anyNumber);
-    SchemaValue spawnValue(spawnGroup);
+    JsonBinding<EnvironmentSpec::Point> spawnGroup;
+    spawnGroup.expect("x", &EnvironmentSpec::Point::x, SchemaValue::anyNumber);
+    spawnGroup.expect("y", &EnvironmentSpec::Point::y, SchemaValue::anyNumber);
 
     // Victory zone
-    SchemaGroup winZoneGroup;
-    winZoneGroup.addExpectedField("top", SchemaValue::positiveNumber);
-    winZoneGroup.addExpectedField("left", SchemaValue::positiveNumber);
-    winZoneGroup.addExpectedField("width", SchemaValue::positiveNumber);
-    winZoneGroup.addExpectedField("height", SchemaValue::positiveNumber);
-    SchemaValue winGroupValue(winZoneGroup);
+    JsonBinding<EnvironmentSpec::Region> winZoneGroup;
+    winZoneGroup.expect("top", &EnvironmentSpec::Region::top, SchemaValue::positiveNumber);
+    winZoneGroup.expect("left", &EnvironmentSpec::Region::left, SchemaValue::positiveNumber);
+    winZoneGroup.expect("width", &EnvironmentSpec::Region::width, SchemaValue::positiveNumber);
+    winZoneGroup.expect("height", &EnvironmentSpec::Region::height, SchemaValue::positiveNumber);
 
     // Main Schema
-    SchemaGroup mainGroup;
-    mainGroup.addExpectedField("name", SchemaValue::anyString);
-    mainGroup.addExpectedField("width", SchemaValue::positiveNumber);
-    mainGroup.addExpectedField("height", SchemaValue::positiveNumber);
-    mainGroup.addExpectedField("background", backgroundValue);
-    mainGroup.addExpectedField("winZone", winGroupValue);
-    mainGroup.addExpectedField("playerSpawn", spawnValue);
-    mainGroup.addExpectedField("entities", entityListValue);
-    
-    return JsonSchema(mainGroup);
+    JsonBinding<EnvironmentSpec> mainGroup;
+    mainGroup.expect("name", &EnvironmentSpec::name, SchemaValue::anyString);
+    mainGroup.expect("width", &EnvironmentSpec::width, SchemaValue::positiveNumber);
+    mainGroup.expect("height", &EnvironmentSpec::height, SchemaValue::positiveNumber);
+    mainGroup.expect("background", &EnvironmentSpec::background, Schemas::backgroundBinding());
+    mainGroup.expect("winZone", &EnvironmentSpec::winZone, winZoneGroup);
+    mainGroup.expect("playerSpawn", &EnvironmentSpec::playerSpawn, spawnGroup);
+    mainGroup.expect("entities", &EnvironmentSpec::entities, Schemas::entityBinding());
+
+    return mainGroup;
 }
 
 } // namespace
 
-const JsonSchema& Schemas::environmentFileSchema() {
-    static const JsonSchema schema = createEnvironmentSchema();
-    return schema;
+const JsonBinding<EnvironmentSpec>& Schemas::environmentFileBinding() {
+    static const JsonBinding<EnvironmentSpec> binding = createEnvironmentBinding();
+    return binding;
 }
 
-const JsonSchema& Schemas::backgroundSchema() {
-    static const JsonSchema schema = createBackgroundSchema();
-    return schema;
+const JsonBinding<BackgroundSpec>& Schemas::backgroundBinding() {
+    static const JsonBinding<BackgroundSpec> binding = createBackgroundBinding();
+    return binding;
 }
 
-const JsonSchema& Schemas::entitySchema() {
-    static const JsonSchema schema = createEntitySchema();
-    return schema;
+const JsonBinding<EntitySpec>& Schemas::entityBinding() {
+    static const JsonBinding<EntitySpec> binding = createEntityBinding();
+    return binding;
 }
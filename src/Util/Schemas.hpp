@@ -1,23 +1,27 @@
 #ifndef SCHEMAS_HPP
 #define SCHEMAS_HPP
 
-#include <Util/JSON/JsonSchema.hpp>
+#include <Util/JSON/JsonBinding.hpp>
+#include <Environment/EnvironmentSpec.hpp>
 
+/**
+ * File formats of the game. Each binding both validates and loads its format
+ */
 struct Schemas {
     /**
-     * Returns the schema for the Environment file
+     * Returns the binding for the Environment file
      */
-    static const JsonSchema& environmentFileSchema();
+    static const JsonBinding<EnvironmentSpec>& environmentFileBinding();
 
     /**
-     * Returns the schema for an Entity
+     * Returns the binding for an Entity
      */
-    static const JsonSchema& entitySchema();
+    static const JsonBinding<EntitySpec>& entityBinding();
 
     /**
-     * Returns the schema for a background
+     * Returns the binding for a background
      */
-    static const JsonSchema& backgroundSchema();
+    static const JsonBinding<BackgroundSpec>& backgroundBinding();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <Util/SlabAllocator.hpp>
+
+namespace {
+constexpr std::size_t ClassCount = SlabAllocator::MaxBlockSize / SlabAllocator::Granularity;
+
+std::size_t classIndex(std::size_t size) {
+    return (size + SlabAllocator::Granularity - 1) / SlabAllocator::Granularity - 1;
+}
+}
+
+SlabAllocator::SlabAllocator(std::size_t blockSize)
+: blockSize(blockSize), freeList(nullptr) {}
+
+SlabAllocator& SlabAllocator::forSize(std::size_t size) {
+    // Allocators are created on first use and never destroyed so that they outlive any pooled
+    // objects destroyed during static destruction
+    static SlabAllocator* classes[ClassCount] = {};
+    SlabAllocator*& allocator = classes[classIndex(size)];
+    if (!allocator)
+        allocator = new SlabAllocator((classIndex(size) + 1) * Granularity);
+    return *allocator;
+}
+
+void* SlabAllocator::allocate(std::size_t size) {
+    if (size == 0 || size > MaxBlockSize)
+        return ::operator new(size);
+    return forSize(size).allocateBlock();
+}
+
+void SlabAllocator::deallocate(void* block, std::size_t size) {
+    if (!block)
+        return;
+    if (size == 0 || size > MaxBlockSize)
+        ::operator delete(block);
+    else
+        forSize(size).deallocateBlock(block);
+}
+
+void* SlabAllocator::allocateBlock() {
+    if (!freeList) {
+        char* slab = static_cast<char*>(::operator new(SlabSize));
+        for (std::size_t offset = 0; offset + blockSize <= SlabSize; offset += blockSize) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + offset);
+            block->next = freeList;
+            freeList = block;
+        }
+    }
+
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    return block;
+}
+
+void SlabAllocator::deallocateBlock(void* block) {
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeList;
+    freeList = freed;
+}
@@ -0,0 +1,77 @@
+#ifndef SLABALLOCATOR_HPP
+#define SLABALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+
+/**
+ * Fixed size block allocator. Blocks are carved out of large slabs and recycled through a free
+ * list, so allocating and freeing is a couple of pointer operations. Slabs are never returned to
+ * the system. Blocks are grouped into size classes that are multiples of 16 bytes. Sizes too large
+ * for any class go to the global allocator
+ *
+ * Not thread safe. Pooled objects must be created and destroyed on the main thread
+ */
+class SlabAllocator {
+public:
+    static constexpr std::size_t Granularity = 16;
+    static constexpr std::size_t MaxBlockSize = 1024;
+    static constexpr std::size_t SlabSize = 64 * 1024;
+
+    /**
+     * Allocates a block of at least the given size
+     */
+    static void* allocate(std::size_t size);
+
+    /**
+     * Frees a block allocated with the same size
+     */
+    static void deallocate(void* block, std::size_t size);
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    const std::size_t blockSize;
+    FreeBlock* freeList;
+
+    SlabAllocator(std::size_t blockSize);
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    static SlabAllocator& forSize(std::size_t size);
+
+    void* allocateBlock();
+    void deallocateBlock(void* block);
+};
+
+/**
+ * Standard allocator over SlabAllocator. Single object allocations are pooled. Used to place the
+ * control blocks of shared pointers in the pools as well
+ */
+template<typename T>
+struct PoolAllocator {
+    typedef T value_type;
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(SlabAllocator::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        SlabAllocator::deallocate(p, n * sizeof(T));
+    }
+
+    template<typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+
+    template<typename U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+#endif
\ No newline at end of file
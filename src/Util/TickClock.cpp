@@ -0,0 +1,47 @@
+#include <Util/TickClock.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <Util/Timer.hpp>
+
+TickClock::TickClock(float tickLength)
+: tickLength(std::max<std::int64_t>(std::llround(tickLength * 1e9), 1))
+, lastTickTime(Timer::get().timeElapsedNanoseconds())
+, tick(0)
+, paused(false) {}
+
+unsigned int TickClock::getDueTicks(unsigned int maxTicks) const {
+    if (paused)
+        return 0;
+    const std::int64_t due = (Timer::get().timeElapsedNanoseconds() - lastTickTime) / tickLength;
+    return std::min<std::int64_t>(std::max<std::int64_t>(due, 0), maxTicks);
+}
+
+void TickClock::advance(unsigned int ticks) {
+    tick += ticks;
+    lastTickTime += ticks * tickLength;
+    lastTickTime = std::max(lastTickTime, Timer::get().timeElapsedNanoseconds() - tickLength);
+}
+
+std::uint64_t TickClock::getTick() const {
+    return tick;
+}
+
+std::int64_t TickClock::getTickLength() const {
+    return tickLength;
+}
+
+void TickClock::pause() {
+    paused = true;
+}
+
+void TickClock::resume() {
+    if (!paused)
+        return;
+    paused = false;
+    lastTickTime = Timer::get().timeElapsedNanoseconds();
+}
+
+bool TickClock::isPaused() const {
+    return paused;
+}
\ No newline at end of file
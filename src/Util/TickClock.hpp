@@ -0,0 +1,67 @@
+#ifndef TICKCLOCK_HPP
+#define TICKCLOCK_HPP
+
+#include <cstdint>
+
+/**
+ * Paces a simulation that advances in fixed ticks. Ticks fall due as time passes on the global
+ * Timer, counted in integer nanoseconds so that the pace does not drift in long sessions. Time
+ * does not pass while either the Timer or the clock itself is paused
+ *
+ * \ingroup Util
+ */
+class TickClock {
+public:
+    /**
+     * Creates the clock with no ticks due
+     *
+     * \param tickLength Seconds of real time per tick
+     */
+    explicit TickClock(float tickLength);
+
+    /**
+     * Returns the number of ticks that are due to be simulated
+     *
+     * \param maxTicks Most ticks to return. Keeps a slow frame from causing more slow frames
+     */
+    unsigned int getDueTicks(unsigned int maxTicks) const;
+
+    /**
+     * Marks ticks as simulated. Time more than a tick behind is dropped, so a simulation that
+     * can not keep up falls behind rather than spiralling
+     */
+    void advance(unsigned int ticks);
+
+    /**
+     * Returns the number of ticks simulated so far
+     */
+    std::uint64_t getTick() const;
+
+    /**
+     * Returns the length of a tick in nanoseconds
+     */
+    std::int64_t getTickLength() const;
+
+    /**
+     * Stops ticks from falling due until resume() is called. Does nothing if already paused
+     */
+    void pause();
+
+    /**
+     * Resumes ticking from now. Time spent paused is skipped. Does nothing if not paused
+     */
+    void resume();
+
+    /**
+     * Tells whether or not the clock is paused
+     */
+    bool isPaused() const;
+
+private:
+    std::int64_t tickLength;
+    std::int64_t lastTickTime;
+    std::uint64_t tick;
+    bool paused;
+};
+
+#endif
\ No newline at end of file
@@ -1,38 +1,51 @@
 #include <Util/Timer.hpp>
 using namespace sf;
 
-Timer::Timer() : paused(false) {}
+Timer::Timer() : start(Clock::now()), timePaused(0), offset(0), paused(false) {}
 
 Timer& Timer::get() {
     static Timer timer;
     return timer;
 }
 
+std::int64_t Timer::rawNanoseconds() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+}
+
 Time Timer::timeElapsedRaw() const {
-    return clock.getElapsedTime();
+    return microseconds(rawNanoseconds() / 1000);
+}
+
+std::int64_t Timer::timeElapsedNanoseconds() const {
+    return (paused ? timePaused : rawNanoseconds()) - offset;
 }
 
 Time Timer::timeElapsed() const {
-    Time ret = clock.getElapsedTime() - offset;
-    if (paused)
-        ret -= (clock.getElapsedTime() - timePaused);
-    return ret;
+    return microseconds(timeElapsedNanoseconds() / 1000);
 }
 
 float Timer::timeElapsedSeconds() const {
-    return timeElapsed().asSeconds();
+    return timeElapsedNanoseconds() / 1e9;
 }
 
-unsigned long int Timer::timeElapsedMilliseconds() const {
-    return timeElapsed().asMilliseconds();
+std::uint64_t Timer::timeElapsedMilliseconds() const {
+    return timeElapsedNanoseconds() / 1000000;
 }
 
 void Timer::pause() {
+    if (paused)
+        return;
     paused = true;
-    timePaused = clock.getElapsedTime();
+    timePaused = rawNanoseconds();
 }
 
 void Timer::resume() {
+    if (!paused)
+        return;
     paused = false;
-    offset += clock.getElapsedTime() - timePaused;
+    offset += rawNanoseconds() - timePaused;
+}
+
+bool Timer::isPaused() const {
+    return paused;
 }
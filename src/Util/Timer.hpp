@@ -1,11 +1,13 @@
 #ifndef TIMER_HPP
 #define TIMER_HPP
 
+#include <chrono>
+#include <cstdint>
 #include <SFML/System.hpp>
 
 /**
- * Global class for tracking time. Implemented over the top of sf::Clock
- * to allow for pausing
+ * Global class for tracking time. Implemented over a monotonic clock counting 64 bit integer
+ * nanoseconds, so precision does not degrade over long sessions. Supports pausing
  *
  * \ingroup Util
  */
@@ -17,14 +19,20 @@ public:
     static Timer& get();
 
     /**
-     * Returns the time elapsed in seconds
+     * Returns the time elapsed in nanoseconds. Exact for any session length
+     */
+    std::int64_t timeElapsedNanoseconds() const;
+
+    /**
+     * Returns the time elapsed in seconds. Loses precision as the session grows, prefer
+     * timeElapsedNanoseconds() for measuring intervals
      */
     float timeElapsedSeconds() const;
 
     /**
      * Returns the time elapsed in milliseconds
      */
-    unsigned long int timeElapsedMilliseconds() const;
+    std::uint64_t timeElapsedMilliseconds() const;
 
     /**
      * Returns the elapsed time
@@ -46,7 +54,14 @@ public:
      */
     void resume();
 
+    /**
+     * Tells whether or not the timer is paused
+     */
+    bool isPaused() const;
+
 private:
+    typedef std::chrono::steady_clock Clock;
+
     /**
      * Starts the timer
      */
@@ -55,8 +70,10 @@ private:
     Timer(const Timer&) = delete;
     Timer& operator=(const Timer&) = delete;
 
-    sf::Clock clock;
-    sf::Time timePaused, offset;
+    std::int64_t rawNanoseconds() const;
+
+    Clock::time_point start;
+    std::int64_t timePaused, offset;
     bool paused;
 };
 
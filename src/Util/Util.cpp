@@ -1,31 +1,19 @@
 #include <Util/Util.hpp>
+#include <Util/Random.hpp>
 #include <cstdlib>
 #include <algorithm>
 #include <sstream>
 #include <iostream>
-#include <random>
-#include <limits>
 using namespace std;
 
-namespace {
-std::random_device rngdev;
-std::mt19937 rng(rngdev());
-}
-
 int randomInt(int mn, int mx) {
-	if (mn>mx)
-		std::swap(mn,mx);
-    std::uniform_int_distribution<std::mt19937::result_type> dist(mn,mx);
-	return dist(rng);
+    return Random::local().nextInt(mn, mx);
 }
 
 float randomFloat(float mn, float mx) {
     if (mn > mx)
         std::swap(mn, mx);
-    const int mr = std::numeric_limits<int>::max() - 1;
-    const float r = randomInt(0, mr);
-    const float scaled = r / static_cast<float>(mr) * (mx - mn);
-    return mn + scaled;
+    return Random::local().nextFloat(mn, mx);
 }
 
 string intToString(int i)
@@ -3,8 +3,14 @@
 
 #include <string>
 
+/**
+ * Returns a random int in [mn, mx] from the calling thread's Random generator
+ */
 int randomInt(int mn, int mx);
 
+/**
+ * Returns a random float in [mn, mx) from the calling thread's Random generator
+ */
 float randomFloat(float mn, float mx);
 
 std::string intToString(int i);
@@ -1,4 +1,17 @@
 #include <Environment/Environment.hpp>
+#include <Environment/RewindBuffer.hpp>
+#include <Entities/Controllers/PlayerController.hpp>
+#include <Headless/Benchmark.hpp>
+#include <Headless/LockstepBot.hpp>
+#include <Headless/Replay.hpp>
+#include <Headless/SelfTest.hpp>
+#include <Network/LockstepController.hpp>
+#include <Network/LockstepRunner.hpp>
+#include <Util/FileWatcher.hpp>
+#include <Util/Profiler.hpp>
+#include <Util/Random.hpp>
+#include <Util/ResourcePool.hpp>
+#include <Util/TickClock.hpp>
 #include <Util/Timer.hpp>
 #include <Util/Util.hpp>
 #include <Properties.hpp>
@@ -6,21 +19,148 @@
 #include <cstdlib>
 #include <ctime>
 
-int main() {
+int main(int argc, char** argv) {
     srand(time(0));
+
+    // SpaceRace --benchmark [entities] [ticks]
+    if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+        const int entityCount = argc > 2 ? stringToInt(argv[2]) : 1000;
+        const int ticks = argc > 3 ? stringToInt(argv[3]) : 100;
+        return Benchmark::run(std::max(entityCount, 0), std::max(ticks, 0));
+    }
+
+    // SpaceRace --selftest
+    if (argc > 1 && std::string(argv[1]) == "--selftest")
+        return SelfTest::run();
+
+    // SpaceRace --replay file
+    if (argc > 2 && std::string(argv[1]) == "--replay")
+        return Replay::run(argv[2]);
+
+    // SpaceRace --lockstep player players port host:port... [options]
+    //   --delay ticks      Input delay
+    //   --rollback ticks   Predict remote input up to this far ahead and roll back on mistakes
+    //   --budget ticks     Most ticks simulated again per frame after a rollback
+    //   --latency ms, --jitter ms, --loss percent   Simulate a poor network on outgoing packets
+    //   --outage ms ms     Drop every outgoing packet from the first time for the second
+    //   --bot ticks        Play without a window
+    // Every player in a networked race lists the others as peers
+    LockstepSession::Ptr session;
+    unsigned int resimulationBudget = 32;
+    if (argc > 4 && std::string(argv[1]) == "--lockstep") {
+        LockstepSession::Config config;
+        config.playerId = std::max(stringToInt(argv[2]), 0);
+        config.playerCount = std::max(stringToInt(argv[3]), 1);
+        config.port = std::max(stringToInt(argv[4]), 0);
+        int botTicks = 0;
+        int delay = -1;
+        for (int i = 5; i<argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--delay" && i+1 < argc)
+                delay = std::max(stringToInt(argv[++i]), 1);
+            else if (arg == "--rollback" && i+1 < argc)
+                config.maxPrediction = std::max(stringToInt(argv[++i]), 0);
+            else if (arg == "--budget" && i+1 < argc)
+                resimulationBudget = std::max(stringToInt(argv[++i]), 1);
+            else if (arg == "--latency" && i+1 < argc)
+                config.network.latency = sf::milliseconds(stringToInt(argv[++i]));
+            else if (arg == "--jitter" && i+1 < argc)
+                config.network.jitter = sf::milliseconds(stringToInt(argv[++i]));
+            else if (arg == "--loss" && i+1 < argc)
+                config.network.loss = stringToInt(argv[++i]) / 100.0f;
+            else if (arg == "--outage" && i+2 < argc) {
+                config.network.outageStart = sf::milliseconds(stringToInt(argv[++i]));
+                config.network.outage = sf::milliseconds(stringToInt(argv[++i]));
+            }
+            else if (arg == "--bot" && i+1 < argc)
+                botTicks = stringToInt(argv[++i]);
+            else {
+                LockstepSession::Peer peer;
+                if (!LockstepSession::parsePeer(arg, peer))
+                    return 1;
+                config.peers.push_back(peer);
+            }
+        }
+        // Rollback hides latency by itself, so it only needs a short delay
+        if (delay > 0)
+            config.inputDelay = delay;
+        else if (config.maxPrediction > 0)
+            config.inputDelay = 2;
+        if (botTicks > 0)
+            return LockstepBot::run(config, botTicks, resimulationBudget);
+
+        session = LockstepSession::create(config);
+        if (!session)
+            return 1;
+        Random::setSeed(config.seed);
+    }
+
     Properties::PrimaryFont.loadFromFile(Properties::FontPath+"PressStart2P.ttf");
 
-    Environment environment("test.json");
+    // SpaceRace --record file. Input is recorded and the simulation runs at a fixed tick length so
+    // that the run can be played back with --replay
+    const std::string environmentFile = "test.json";
+    InputRecording::Ptr recording;
+    if (argc > 2 && std::string(argv[1]) == "--record") {
+        recording = InputRecording::create(environmentFile, Random::getSeed(), Properties::FixedTickLength);
+        Random::setSeed(recording->getSeed());
+    }
+
+    Environment environment(environmentFile);
+    if (recording)
+        environment.setPlayerController(PlayerController::create(recording));
+
+    // Recordings need chunks to arrive on the same tick when played back, and rollback needs the
+    // entity set to stay the same as in its snapshots
+    if (session)
+        environment.setStreaming(Environment::Resident);
+    else if (recording)
+        environment.setStreaming(Environment::Synchronous);
+    std::unique_ptr<LockstepRunner> lockstep;
+    if (session) {
+        LockstepController::setupPlayers(environment, session);
+        lockstep.reset(new LockstepRunner(environment, session, resimulationBudget));
+    }
+
+    // The best finish in this environment races along as a ghost
+    const std::string ghostFile = Properties::GameSavePath +
+        environmentFile.substr(0, environmentFile.find_last_of('.')) + ".ghost";
+    GhostTrack::Ptr bestRun = GhostTrack::load(ghostFile);
+    float bestTime = 0;
+    if (bestRun) {
+        environment.addGhost(bestRun);
+        bestTime = bestRun->getDuration();
+    }
+    Environment::PlayerStatus lastStatus = environment.getPlayerStatus();
+
+    // Recorded and networked games step at a fixed tick length and only input may change them
+    const bool fixedStep = recording || session;
+
+    // Changed resources are reloaded in place
+    FileWatcher watcher;
+    watcher.watch(Properties::EnvironmentFilePath);
+    watcher.watch(Properties::EntityAnimationPath);
+    watcher.watch(Properties::EnvironmentAnimPath);
+    watcher.watch(Properties::EntityImagePath);
+    watcher.watch(Properties::EnvironmentImagePath);
+    watcher.watch(Properties::SpriteSheetPath);
+
     sf::RenderWindow window(
         sf::VideoMode(Properties::ScreenWidth, Properties::ScreenHeight, 32),
         "Space Race",
         sf::Style::Close | sf::Style::Titlebar
     );
 
-    const float renderTimeGap = 0.015; // ~60 fps
-    const float minPhysicsTime = 0.002; // 500 fps
-    float lastPhysicsTime = Timer::get().timeElapsedSeconds();
-    float lastRenderTime = Timer::get().timeElapsedSeconds();
+    // Loop timing is in integer nanoseconds so that it stays exact in long sessions
+    const std::int64_t renderTimeGap = 15000000; // ~60 fps
+    const std::int64_t minLoopTime = 2000000; // 500 fps
+    std::int64_t lastLoopTime = Timer::get().timeElapsedNanoseconds();
+    std::int64_t lastRenderTime = Timer::get().timeElapsedNanoseconds();
+
+    // The simulation always steps at the fixed tick length. Free play has always run at half speed,
+    // so its ticks are paced at twice the length
+    const unsigned int maxTicksPerLoop = 4;
+    TickClock ticks(fixedStep ? Properties::FixedTickLength : Properties::FixedTickLength * 2);
 
     float fps = 60;
     sf::Text fpsText;
@@ -31,6 +171,18 @@ int main() {
     fpsText.setOutlineThickness(1);
     fpsText.setPosition({10,10});
 
+    CountingRenderTarget renderTarget(window);
+
+    // F3 toggles the profiler overlay, F4 writes the recorded zones out
+    bool showProfiler = false;
+
+    // Holding backspace rewinds. Not available in recorded and networked games
+    RewindBuffer rewind(32 * 1024 * 1024, 2, 32);
+
+    // F5 quicksaves the simulation state, F9 restores it
+    const std::string quicksaveFile = Properties::GameSavePath+"quicksave.snap";
+    Snapshot quicksave;
+
     while (window.isOpen()) {
         sf::Event event;
         while (window.pollEvent(event)) {
@@ -38,27 +190,120 @@ int main() {
                 window.close();
                 break;
             }
+            if (event.type == sf::Event::KeyPressed) {
+                if (event.key.code == sf::Keyboard::F3)
+                    showProfiler = !showProfiler;
+                else if (event.key.code == sf::Keyboard::F4) {
+                    Profiler::get().exportCsv(Properties::GameSavePath+"profile.csv");
+                    Profiler::get().exportChromeTrace(Properties::GameSavePath+"profile.json");
+                    std::cout << "Wrote profile.csv and profile.json" << std::endl;
+                }
+                else if (event.key.code == sf::Keyboard::F5) {
+                    environment.saveState(quicksave);
+                    if (quicksave.save(quicksaveFile))
+                        std::cout << "Quicksaved to " << quicksaveFile << std::endl;
+                }
+                else if (event.key.code == sf::Keyboard::F9) {
+                    if (fixedStep)
+                        std::cout << "Quickload is disabled in recorded and networked games" << std::endl;
+                    else if (quicksave.load(quicksaveFile) && environment.loadState(quicksave)) {
+                        rewind.clear();
+                        std::cout << "Loaded " << quicksaveFile << std::endl;
+                    }
+                }
+            }
         }
 
-        environment.update((Timer::get().timeElapsedSeconds() - lastPhysicsTime)/2);
+        for (const std::string& file : watcher.poll()) {
+            if (file == environment.getFilename()) {
+                if (!fixedStep) {
+                    environment.reload();
+                    rewind.clear();
+                }
+            }
+            else if (imagePool.reloadResource(file) || animPool.reloadResource(file))
+                std::cout << "Reloaded " << file << std::endl;
+        }
 
-        if (Timer::get().timeElapsedSeconds() - lastRenderTime >= renderTimeGap) {
-            environment.render(window);
+        if (lockstep) {
+            // Ticks the runner could not simulate yet stay due
+            const LockstepRunner::Stats stats = lockstep->update(ticks.getDueTicks(maxTicksPerLoop), InputFrame::fromKeyboard);
+            ticks.advance(stats.simulated);
+            Profiler::get().setCounter("Rollback ticks", stats.resimulated);
+            if (lockstep->hasFailed())
+                window.close();
+        }
+        else if (recording) {
+            const unsigned int due = ticks.getDueTicks(maxTicksPerLoop);
+            for (unsigned int i = 0; i<due; ++i)
+                environment.update(Properties::FixedTickLength);
+            ticks.advance(due);
+        }
+        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::BackSpace)) {
+            // One sample per rendered frame, roughly real time. The simulation waits meanwhile
+            ticks.pause();
+            if (Timer::get().timeElapsedNanoseconds() - lastRenderTime >= renderTimeGap && rewind.stepBack(environment))
+                Profiler::get().setCounter("Rewind restore (us)", rewind.getLastRestoreTime().asMicroseconds());
+        }
+        else {
+            ticks.resume();
+            const unsigned int due = ticks.getDueTicks(maxTicksPerLoop);
+            for (unsigned int i = 0; i<due; ++i) {
+                environment.update(Properties::FixedTickLength);
+                rewind.record(environment);
+            }
+            ticks.advance(due);
+        }
+
+        if (environment.getPlayerStatus() == Environment::Won && lastStatus != Environment::Won) {
+            const float time = environment.getPlayerTrack().getDuration();
+            std::cout << "Finished in " << time << "s" << std::endl;
+            if ((bestTime <= 0 || time < bestTime) && environment.getPlayerTrack().save(ghostFile)) {
+                std::cout << "New best, saved ghost to " << ghostFile << std::endl;
+                bestTime = time;
+            }
+        }
+        lastStatus = environment.getPlayerStatus();
+
+        if (Timer::get().timeElapsedNanoseconds() - lastRenderTime >= renderTimeGap) {
+            environment.render(renderTarget);
 
-            fps = 0.9 * fps + 0.1 / (Timer::get().timeElapsedSeconds() - lastRenderTime);
+            fps = 0.9 * fps + 0.1 * 1e9 / (Timer::get().timeElapsedNanoseconds() - lastRenderTime);
             fpsText.setString("FPS: " + intToString(fps));
-            window.setView(window.getDefaultView());
-            window.draw(fpsText);
-            
-            window.display();
-            lastRenderTime = Timer::get().timeElapsedSeconds();
+            renderTarget.setView(renderTarget.getDefaultView());
+            renderTarget.draw(fpsText);
+
+            const CountingRenderTarget::Stats renderStats = renderTarget.endFrame();
+            Profiler::get().setCounter("Draw calls", renderStats.drawCalls);
+            Profiler::get().setCounter("Vertices", renderStats.vertices);
+            Profiler::get().setCounter("Texture switches", renderStats.textureSwitches);
+            Profiler::get().setCounter("State changes", renderStats.stateChanges);
+            Profiler::get().setCounter("Rewind memory (KB)", rewind.getMemoryUsage() / 1024);
+            Profiler::get().setCounter("Rewind ticks", rewind.getTickSpan());
+            if (showProfiler)
+                Profiler::get().renderOverlay(window, Properties::PrimaryFont);
+
+            {
+                PROFILE_ZONE("Display");
+                window.display();
+            }
+            Profiler::get().endFrame();
+            lastRenderTime = Timer::get().timeElapsedNanoseconds();
         }
 
-        const float refTime = std::max(lastRenderTime, lastPhysicsTime);
-        const float sleepTime = Timer::get().timeElapsedSeconds() - refTime;
-        lastPhysicsTime = Timer::get().timeElapsedSeconds();
-        if (minPhysicsTime - sleepTime > 0)
-            sf::sleep(sf::seconds(minPhysicsTime - sleepTime));
+        const std::int64_t refTime = std::max(lastRenderTime, lastLoopTime);
+        const std::int64_t loopTime = Timer::get().timeElapsedNanoseconds() - refTime;
+        lastLoopTime = Timer::get().timeElapsedNanoseconds();
+        if (minLoopTime - loopTime > 0)
+            sf::sleep(sf::microseconds((minLoopTime - loopTime) / 1000));
+    }
+
+    if (recording) {
+        Snapshot state;
+        environment.saveState(state);
+        recording->setFinalChecksum(state.checksum());
+        if (recording->save(argv[2]))
+            std::cout << "Recorded " << recording->size() << " ticks to " << argv[2] << std::endl;
     }
 
     return 0;
@@ -0,0 +1,63 @@
+#include <Media/AnimationFormat.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+/**
+ * Converts .anim files to the v2 format in place. Files already in the v2 format are skipped.
+ * Pass --out <file> after a single input to write the result somewhere else
+ *
+ * Usage: AnimConverter <file.anim> [file.anim ...]
+ *        AnimConverter <file.anim> --out <converted.anim>
+ */
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <file.anim> [file.anim ...]" << std::endl;
+        std::cout << "       " << argv[0] << " <file.anim> --out <converted.anim>" << std::endl;
+        return 1;
+    }
+
+    if (argc == 4 && std::string(argv[2]) == "--out") {
+        AnimationFormat::Data data;
+        if (!AnimationFormat::load(argv[1], data))
+            return 1;
+        return AnimationFormat::save(argv[3], data) ? 0 : 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string file = argv[i];
+        AnimationFormat::Data data;
+        int version = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        if (!AnimationFormat::load(file, data, &version)) {
+            ++failures;
+            continue;
+        }
+        const auto loaded = std::chrono::steady_clock::now();
+
+        if (version == AnimationFormat::CurrentVersion) {
+            std::cout << file << ": already v" << version << std::endl;
+            continue;
+        }
+        if (!AnimationFormat::save(file, data)) {
+            ++failures;
+            continue;
+        }
+
+        AnimationFormat::Data converted;
+        const auto reloadStart = std::chrono::steady_clock::now();
+        AnimationFormat::load(file, converted);
+        const auto reloaded = std::chrono::steady_clock::now();
+
+        std::cout << file << ": v" << version << " -> v" << AnimationFormat::CurrentVersion
+                  << " (" << data.frames.size() << " frames, " << data.pieces.size() << " pieces, load "
+                  << std::chrono::duration<double, std::micro>(loaded - start).count() << "us -> "
+                  << std::chrono::duration<double, std::micro>(reloaded - reloadStart).count() << "us)"
+                  << std::endl;
+    }
+
+    return failures == 0 ? 0 : 1;
+}
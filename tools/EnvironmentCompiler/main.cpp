@@ -0,0 +1,81 @@
+#include <Environment/EnvironmentFormat.hpp>
+#include <Util/JsonFile.hpp>
+#include <Util/Schemas.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+bool compile(const std::string& input, const std::string& output, float chunkSize) {
+    const auto start = std::chrono::steady_clock::now();
+    JsonFile file(input);
+    EnvironmentSpec spec;
+    if (!Schemas::environmentFileBinding().load(file.getRoot(), spec, true)) {
+        std::cerr << input << ": failed to validate" << std::endl;
+        return false;
+    }
+    const auto parsed = std::chrono::steady_clock::now();
+
+    if (!EnvironmentFormat::save(output, spec, chunkSize))
+        return false;
+
+    EnvironmentSpec compiled;
+    EnvironmentFormat::ChunkTable table;
+    const auto loadStart = std::chrono::steady_clock::now();
+    if (!EnvironmentFormat::load(output, compiled, &table))
+        return false;
+    const auto loaded = std::chrono::steady_clock::now();
+
+    std::cout << input << " -> " << output << " (" << spec.entities.size() << " entities, "
+              << spec.background.elements.size() << " background elements, " << table.chunks.size() << " chunks, load "
+              << std::chrono::duration<double, std::micro>(parsed - start).count() << "us -> "
+              << std::chrono::duration<double, std::micro>(loaded - loadStart).count() << "us)"
+              << std::endl;
+    return true;
+}
+
+std::string outputName(const std::string& input) {
+    const std::size_t dot = input.find_last_of('.');
+    const std::size_t slash = input.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return input + EnvironmentFormat::Extension;
+    return input.substr(0, dot) + EnvironmentFormat::Extension;
+}
+}
+
+/**
+ * Compiles json environment files into the binary format loaded by shipping builds. The output is
+ * written next to the input with the compiled extension unless --out is given. With --chunk the
+ * static entities are split into square chunks of the given size which are streamed in as the player
+ * approaches
+ *
+ * Usage: EnvironmentCompiler [--chunk <size>] <file.json> [file.json ...]
+ *        EnvironmentCompiler [--chunk <size>] <file.json> --out <compiled.senv>
+ */
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    float chunkSize = 0;
+    if (args.size() >= 2 && args[0] == "--chunk") {
+        chunkSize = std::atof(args[1].c_str());
+        args.erase(args.begin(), args.begin() + 2);
+    }
+
+    if (args.empty()) {
+        std::cout << "Usage: " << argv[0] << " [--chunk <size>] <file.json> [file.json ...]" << std::endl;
+        std::cout << "       " << argv[0] << " [--chunk <size>] <file.json> --out <compiled" << EnvironmentFormat::Extension << ">" << std::endl;
+        return 1;
+    }
+
+    if (args.size() == 3 && args[1] == "--out")
+        return compile(args[0], args[2], chunkSize) ? 0 : 1;
+
+    int failures = 0;
+    for (const std::string& input : args) {
+        if (!compile(input, outputName(input), chunkSize))
+            ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}